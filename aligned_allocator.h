@@ -0,0 +1,47 @@
+#ifndef CRICKET_ALIGNED_ALLOCATOR_H
+#define CRICKET_ALIGNED_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdlib> // For posix_memalign() and free()
+#include <new>
+
+// --- AlignedAllocator Definition ---
+// Allocator that honours alignof(T) for containers of over-aligned types.
+// Before C++17, std::allocator only aligns to 16 bytes, so a
+// std::vector<T> of alignas(64) per-thread slots could still have two
+// threads' slots share a cache line; with this allocator the storage starts
+// on a cache line and each slot (whose size alignas rounds up) has its own.
+template <typename T>
+struct AlignedAllocator {
+    typedef T value_type;
+
+    AlignedAllocator() {}
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        size_t alignment = alignof(T) < sizeof(void*) ? sizeof(void*) : alignof(T);
+        void* memory = nullptr;
+        if (posix_memalign(&memory, alignment, n * sizeof(T)) != 0) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(memory);
+    }
+
+    void deallocate(T* pointer, size_t) {
+        std::free(pointer);
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const AlignedAllocator<T>&, const AlignedAllocator<U>&) {
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const AlignedAllocator<T>&, const AlignedAllocator<U>&) {
+    return false;
+}
+
+#endif // CRICKET_ALIGNED_ALLOCATOR_H
@@ -0,0 +1,121 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>  // For atoll(), malloc() and free()
+#include <new>
+#include "game_pool.h"
+#include "simulator.h"
+
+// --- Allocation counting: every global operator new goes through here ---
+static long long heapAllocations = 0;
+static long long heapBytes = 0;
+
+void* operator new(size_t size) {
+    heapAllocations++;
+    heapBytes += size;
+    void* memory = std::malloc(size > 0 ? size : 1);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+void operator delete[](void* memory) noexcept {
+    std::free(memory);
+}
+void operator delete(void* memory, size_t) noexcept {
+    std::free(memory);
+}
+void operator delete[](void* memory, size_t) noexcept {
+    std::free(memory);
+}
+
+const uint64_t SEED = 42;
+
+// Plays match 'matchIndex' on a Game with empty teams, set up the way Simulator does it;
+// returns TeamA's winning margin as a checksum
+int playMatchOn(Game& game, long long matchIndex) {
+    game.rng = Rng::forStream(SEED, matchIndex);
+    for (int id = 1; id <= 4; ++id) {
+        game.addToTeam(game.teamA, id);
+    }
+    for (int id = 5; id <= 8; ++id) {
+        game.addToTeam(game.teamB, id);
+    }
+    game.decideToss(1, 0);
+    game.simulateInnings(1);
+    game.simulateInnings(2);
+    return game.teamA.totalRuns - game.teamB.totalRuns;
+}
+
+struct Measurement {
+    double seconds;
+    long long allocations;
+    long long bytes;
+    long long checksum;
+};
+
+// Times 'playAll' and counts the heap allocations it makes
+template <typename PlayAll>
+Measurement measure(PlayAll playAll) {
+    long long allocationsBefore = heapAllocations;
+    long long bytesBefore = heapBytes;
+    auto start = std::chrono::steady_clock::now();
+    long long checksum = playAll();
+    auto end = std::chrono::steady_clock::now();
+    Measurement m = {std::chrono::duration<double>(end - start).count(), heapAllocations - allocationsBefore,
+                     heapBytes - bytesBefore, checksum};
+    return m;
+}
+
+void printRow(const char* name, const Measurement& m, long long numMatches) {
+    std::cout << name << "\t" << static_cast<double>(m.allocations) / numMatches << "\t\t"
+              << static_cast<double>(m.bytes) / numMatches << "\t\t" << numMatches / m.seconds << "\n";
+}
+
+// --- Benchmark: heap allocations per match ---
+int main(int argc, char* argv[]) {
+    long long numMatches = (argc > 1) ? atoll(argv[1]) : 1000000;
+
+    // A new Game for every match
+    Measurement fresh = measure([numMatches]() {
+        long long checksum = 0;
+        for (long long i = 0; i < numMatches; ++i) {
+            Game game;
+            checksum += playMatchOn(game, i);
+        }
+        return checksum;
+    });
+
+    // Games from a pool built once, reset in place between matches (pool built outside the timing)
+    GamePool pool(4);
+    Measurement pooled = measure([numMatches, &pool]() {
+        long long checksum = 0;
+        for (long long i = 0; i < numMatches; ++i) {
+            Game* game = pool.acquire();
+            checksum += playMatchOn(*game, i);
+            pool.release(game);
+        }
+        return checksum;
+    });
+
+    // The headless Simulator: one Game, counters zeroed in place when the line-ups repeat
+    Simulator simulator(SEED);
+    SimulationResults results = simulator.makeResults();
+    Measurement simulated = measure([numMatches, &simulator, &results]() {
+        simulator.runRange(0, numMatches, results);
+        return results.teamAWins - results.teamBWins;
+    });
+
+    std::cout << "Matches: " << numMatches << "\n";
+    std::cout << "Game\t\tAllocs/match\tBytes/match\tMatches/s\n";
+    printRow("New per match", fresh, numMatches);
+    printRow("GamePool", pooled, numMatches);
+    printRow("Simulator", simulated, numMatches);
+    std::cout << "Checksums match: " << (fresh.checksum == pooled.checksum ? "yes" : "NO") << "\n";
+    return 0;
+}
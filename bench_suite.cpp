@@ -0,0 +1,277 @@
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <fcntl.h>  // For open()
+#include <unistd.h> // For close()
+#include <cstdlib>  // For atof() and atoi()
+#include "counter_rng.h"
+#include "lockstep_simulator.h"
+#include "match_format.h"
+#include "profiler.h"
+#include "rng.h"
+#include "simulator.h"
+
+// --- Benchmark suite ---
+// Times the hot paths one at a time (RNG, a ball, an innings, a match, a
+// scorecard frame) and writes the results as one JSON document, so runs can
+// be stored and compared to catch regressions. Every case is repeated and
+// reports its best run; all runs are kept in the document.
+
+// One timed run: 'operations' units of work in 'seconds'
+struct BenchRun {
+    long long operations;
+    double seconds;
+};
+
+// Result of one case
+struct BenchResult {
+    std::string name;
+    std::string unit; // What one operation is
+    std::vector<BenchRun> runs;
+
+    double rate(const BenchRun& run) const {
+        return run.seconds > 0 ? run.operations / run.seconds : 0.0;
+    }
+
+    double bestRate() const {
+        double best = 0;
+        for (const BenchRun& run : runs) {
+            best = std::max(best, rate(run));
+        }
+        return best;
+    }
+};
+
+// Options shared by every case
+struct BenchOptions {
+    double scale = 1.0;   // Multiplies every case's amount of work
+    int repeats = 3;
+    std::string filter;   // Only cases whose name contains this
+};
+
+// Keeps the compiler from dropping a computed value
+volatile uint64_t benchSink;
+
+// Runs body(amount) 'repeats' times; body returns the operations it did
+template <typename Body>
+void runCase(const BenchOptions& options, const std::string& name, const std::string& unit, long long amount,
+             std::vector<BenchResult>& results, Body body) {
+    if (!options.filter.empty() && name.find(options.filter) == std::string::npos) {
+        return;
+    }
+    amount = std::max(1LL, static_cast<long long>(amount * options.scale));
+    BenchResult result = {name, unit, {}};
+    for (int r = 0; r < options.repeats; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        long long operations = body(amount);
+        auto end = std::chrono::steady_clock::now();
+        result.runs.push_back(BenchRun{operations, std::chrono::duration<double>(end - start).count()});
+    }
+    std::cerr << name << ": " << result.bestRate() << " " << unit << "/s\n";
+    results.push_back(result);
+}
+
+// Escapes a string for a JSON document
+std::string jsonString(const std::string& text) {
+    std::string out = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += (c == '\n') ? ' ' : c;
+    }
+    return out + "\"";
+}
+
+void writeJson(std::ostream& out, const BenchOptions& options, const std::vector<BenchResult>& results) {
+#ifdef __VERSION__
+    std::string compiler = __VERSION__;
+#else
+    std::string compiler = "unknown";
+#endif
+#ifdef NDEBUG
+    const char* assertions = "false";
+#else
+    const char* assertions = "true";
+#endif
+    out << "{\n";
+    out << "  \"suite\": \"cricket_bench\",\n";
+    out << "  \"schema\": 1,\n";
+    out << "  \"timestamp\": " << static_cast<long long>(std::time(nullptr)) << ",\n";
+    out << "  \"build\": {\"compiler\": " << jsonString(compiler) << ", \"assertions\": " << assertions
+        << ", \"profile\": " << (Profiler::enabled() ? "true" : "false") << "},\n";
+    out << "  \"options\": {\"scale\": " << options.scale << ", \"repeats\": " << options.repeats
+        << ", \"filter\": " << jsonString(options.filter) << "},\n";
+    out << "  \"results\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& result = results[i];
+        out << (i > 0 ? "," : "") << "\n    {\"name\": " << jsonString(result.name) << ", \"unit\": "
+            << jsonString(result.unit) << ", \"per_second\": " << result.bestRate() << ", \"runs\": [";
+        for (size_t r = 0; r < result.runs.size(); ++r) {
+            out << (r > 0 ? ", " : "") << "{\"operations\": " << result.runs[r].operations
+                << ", \"seconds\": " << result.runs[r].seconds << "}";
+        }
+        out << "]}";
+    }
+    out << "\n  ],\n";
+    out << "  \"profile\": ";
+    Profiler::writeJson(out);
+    out << "\n}\n";
+}
+
+// --- Main Function ---
+// Usage: cricket_bench [--json FILE] [--scale X] [--repeats N] [--filter NAME]
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    std::string jsonPath;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string option = argv[i];
+        if (option == "--json") {
+            jsonPath = argv[i + 1];
+        } else if (option == "--scale") {
+            options.scale = atof(argv[i + 1]);
+        } else if (option == "--repeats") {
+            options.repeats = std::max(1, atoi(argv[i + 1]));
+        } else if (option == "--filter") {
+            options.filter = argv[i + 1];
+        }
+    }
+    std::vector<BenchResult> results;
+
+    // RNG: raw 64-bit draws and the 0-6 draw of a ball
+    runCase(options, "rng.next", "draws", 50000000, results, [](long long n) {
+        Rng rng(1);
+        uint64_t sum = 0;
+        for (long long i = 0; i < n; ++i) {
+            sum += rng.next();
+        }
+        benchSink = sum;
+        return n;
+    });
+    runCase(options, "rng.below7", "draws", 50000000, results, [](long long n) {
+        Rng rng(1);
+        uint64_t sum = 0;
+        for (long long i = 0; i < n; ++i) {
+            sum += rng.below(7);
+        }
+        benchSink = sum;
+        return n;
+    });
+
+    // Counter-based generator: one addressed ball at a time, and whole innings in bulk
+    runCase(options, "rng.counter.below7", "draws", 20000000, results, [](long long n) {
+        CounterRng counter(1);
+        uint64_t sum = 0;
+        for (long long i = 0; i < n; ++i) {
+            sum += counter.below(7, i / 120, 1, static_cast<int>(i % 120));
+        }
+        benchSink = sum;
+        return n;
+    });
+    runCase(options, "rng.counter.fill", "draws", 50000000, results, [](long long n) {
+        CounterRng counter(1);
+        uint8_t outcomes[120];
+        uint64_t sum = 0;
+        long long innings = n / 120;
+        for (long long i = 0; i < innings; ++i) {
+            counter.fillBelow(7, i, 1, 0, 120, outcomes);
+            sum += outcomes[i % 120];
+        }
+        benchSink = sum;
+        return innings * 120;
+    });
+
+    // One ball at a time through the Game (innings restarted as they end)
+    runCase(options, "ball", "balls", 20000000, results, [](long long n) {
+        Simulator simulator;
+        simulator.setFormat(T20Format::balls, T20Format::players);
+        Game& game = simulator.game;
+        simulator.setUpMatch(0);
+        long long match = 0;
+        for (long long i = 0; i < n; ++i) {
+            if (game.playDeliveries(1) == 0) {
+                simulator.setUpMatch(++match);
+                game.playDeliveries(1);
+            }
+        }
+        benchSink = game.teamA.totalRuns;
+        return n;
+    });
+
+    // Whole innings on the Game loop and on the realistic engine
+    runCase(options, "innings.t20", "innings", 200000, results, [](long long n) {
+        Simulator simulator;
+        simulator.setFormat(T20Format::balls, T20Format::players);
+        for (long long i = 0; i < n; ++i) {
+            simulator.setUpMatch(i);
+            simulator.game.simulateInnings(1);
+        }
+        benchSink = simulator.game.battingTeam->totalRuns;
+        return n;
+    });
+    runCase(options, "innings.t20.realistic", "innings", 200000, results, [](long long n) {
+        Simulator simulator;
+        simulator.setFormat(T20Format::balls, T20Format::players);
+        for (long long i = 0; i < n; ++i) {
+            simulator.setUpMatch(i);
+            simulator.innings.playInnings(simulator.game, 1);
+        }
+        benchSink = simulator.game.battingTeam->totalRuns;
+        return n;
+    });
+
+    // Full matches: the generic Simulator, the specialized formats (one match at a time, on the
+    // counter-based generator and eight in lockstep on the widest kernel), on one thread
+    runCase(options, "match.one-over", "matches", 5000000, results, [](long long n) {
+        Simulator simulator;
+        return simulator.run(n).matches;
+    });
+    for (const auto& format : formatTable()) {
+        runCase(options, std::string("match.") + format.name + ".specialized", "matches",
+                std::max(1LL, 30000000LL / format.balls), results, [&format](long long n) {
+                    return format.run(0, 1, n).matches;
+                });
+        runCase(options, std::string("match.") + format.name + ".counter", "matches",
+                std::max(1LL, 30000000LL / format.balls), results, [&format](long long n) {
+                    return format.runCounter(0, 1, n).matches;
+                });
+        LockstepRunFunction lockstep = findLockstep(format.balls, format.players);
+        runCase(options, std::string("match.") + format.name + ".lockstep", "matches",
+                std::max(1LL, 30000000LL / format.balls), results, [lockstep](long long n) {
+                    return lockstep(0, 1, n).matches;
+                });
+    }
+
+    // Scorecard frames (one per ball) written to /dev/null, full card and in place
+    for (bool inPlace : {false, true}) {
+        runCase(options, inPlace ? "render.in-place" : "render.full", "frames", 100000, results,
+                [inPlace](long long n) {
+                    int devNull = open("/dev/null", O_WRONLY);
+                    Simulator simulator;
+                    simulator.game.scorecard.fd = devNull;
+                    simulator.game.scorecard.inPlace = inPlace;
+                    SimulationResults matchResults = simulator.makeResults();
+                    for (long long i = 0; i < n; ++i) {
+                        simulator.playMatchLive(i, matchResults);
+                    }
+                    close(devNull);
+                    return simulator.game.scorecard.framesWritten;
+                });
+    }
+
+    if (jsonPath.empty()) {
+        writeJson(std::cout, options, results);
+        return 0;
+    }
+    std::ofstream out(jsonPath);
+    writeJson(out, options, results);
+    if (!out) {
+        std::cerr << "Cannot write '" << jsonPath << "'.\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,491 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <memory>
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+#include <thread>
+#include <fcntl.h>  // For open()
+#include <unistd.h> // For close()
+#include <cstdlib>  // For atoll()
+#include <cstring>  // For memcmp()
+#include "clock.h"
+#include "event_loop.h"
+#include "simulator.h"
+#include "parallel_runner.h"
+#include "lockstep_simulator.h"
+#include "match_format.h"
+#include "match_fork.h"
+#include "probability.h"
+#include "tournament.h"
+#include "win_probability.h"
+
+// Returns true if two result sets hold exactly the same counts
+bool sameResults(const SimulationResults& a, const SimulationResults& b) {
+    return a.matches == b.matches && a.balls == b.balls &&
+           a.teamAWins == b.teamAWins && a.teamBWins == b.teamBWins && a.draws == b.draws &&
+           a.battingFirstWins == b.battingFirstWins && a.chasingWins == b.chasingWins &&
+           a.firstInningsScores == b.firstInningsScores && a.secondInningsScores == b.secondInningsScores &&
+           std::equal(a.playerTotals.data(), a.playerTotals.data() + a.playerTotals.size() * NUM_PLAYER_STATS,
+                      b.playerTotals.data());
+}
+
+// Times the exact tables for one format and compares them with simulated frequencies
+template <typename Format>
+void crossValidate(const char* name, long long numMatches) {
+    auto start = std::chrono::steady_clock::now();
+    ExactInnings<Format> exact;
+    auto built = std::chrono::steady_clock::now();
+
+    const int queries = 1000000;
+    double sum = 0.0;
+    for (int i = 0; i < queries; ++i) {
+        sum += exact.chaseWinProbability(i % (ExactInnings<Format>::maxScore() + 2));
+    }
+    auto queried = std::chrono::steady_clock::now();
+    volatile double sink = sum; // Keeps the queries from being optimized away
+    (void)sink;
+
+    SimulationResults simulated = FormatSimulator<Format>(0).run(numMatches);
+    std::vector<double> distribution = exact.firstInningsDistribution();
+    double maxError = 0.0;
+    for (size_t runs = 0; runs < distribution.size(); ++runs) {
+        double frequency = static_cast<double>(simulated.firstInningsScores[runs]) / simulated.matches;
+        maxError = std::max(maxError, std::abs(distribution[runs] - frequency));
+    }
+    MatchOdds odds = exact.matchOdds();
+    double n = static_cast<double>(simulated.matches);
+
+    std::cout << name << "\t" << std::chrono::duration<double, std::milli>(built - start).count()
+              << "\t\t" << std::chrono::duration<double, std::nano>(queried - built).count() / queries
+              << "\t\t" << maxError << "\t\t\t" << odds.chasingWins << "/" << simulated.chasingWins / n
+              << "\t" << odds.draw << "/" << simulated.draws / n << "\n";
+}
+
+// Plays matches with every ball rendered to /dev/null and prints frames per second
+void benchmarkRenderer(const char* name, bool inPlace, long long numMatches) {
+    int devNull = open("/dev/null", O_WRONLY);
+    Simulator simulator;
+    simulator.game.scorecard.fd = devNull;
+    simulator.game.scorecard.inPlace = inPlace;
+    SimulationResults results = simulator.makeResults();
+    auto start = std::chrono::steady_clock::now();
+    for (long long i = 0; i < numMatches; ++i) {
+        simulator.playMatchLive(i, results);
+    }
+    auto end = std::chrono::steady_clock::now();
+    close(devNull);
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << name << "\t" << simulator.game.scorecard.framesWritten / seconds << "\n";
+}
+
+// Plays complete interactive matches (welcome to summary) on an instant clock with scripted input
+void benchmarkInstantMatches(int numMatches) {
+    int devNull = open("/dev/null", O_WRONLY);
+    std::ofstream nullStream("/dev/null");
+    std::streambuf* coutBuffer = std::cout.rdbuf(nullStream.rdbuf());
+    std::streambuf* cinBuffer = std::cin.rdbuf();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < numMatches; ++i) {
+        std::istringstream input("1 2 3 4 5 6 7 8 1 1\n");
+        std::cin.rdbuf(input.rdbuf());
+        Game game;
+        game.clock = Clock::instant();
+        game.scorecard.fd = devNull;
+        game.welcome();
+        game.displayAllPlayers();
+        game.selectPlayers();
+        game.toss();
+        game.startInnings(1);
+        game.startInnings(2);
+        game.displayMatchSummary();
+    }
+    auto middle = std::chrono::steady_clock::now();
+
+    // The same number of matches paced together on one event loop
+    Clock clock = Clock::instant();
+    EventLoop loop(clock);
+    std::vector<std::unique_ptr<PacedMatch>> matches;
+    for (int i = 0; i < numMatches; ++i) {
+        matches.emplace_back(new PacedMatch(loop, 0, i, std::cout));
+        matches.back()->start();
+    }
+    loop.run();
+    auto end = std::chrono::steady_clock::now();
+
+    std::cin.rdbuf(cinBuffer);
+    std::cout.rdbuf(coutBuffer);
+    close(devNull);
+    std::cout << "Interactive match, instant clock: "
+              << std::chrono::duration<double, std::micro>(middle - start).count() / numMatches << " us per match\n";
+    std::cout << "Event loop match, instant clock: "
+              << std::chrono::duration<double, std::micro>(end - middle).count() / numMatches << " us per match ("
+              << clock.nowMicros / 1e6 << " virtual seconds paced)\n";
+}
+
+// Times the Game-based simulator with uniform balls against skill-model balls, and checks
+// one matchup's alias table against its exact distribution
+void benchmarkSkills(const char* name, int balls, int players, long long numMatches) {
+    Simulator uniform;
+    uniform.setFormat(balls, players);
+    auto start = std::chrono::steady_clock::now();
+    SimulationResults uniformResults = uniform.run(numMatches);
+    auto middle = std::chrono::steady_clock::now();
+    Simulator skilled;
+    skilled.setFormat(balls, players);
+    skilled.game.enableSkills();
+    SimulationResults skilledResults = skilled.run(numMatches);
+    auto end = std::chrono::steady_clock::now();
+
+    const Player& batsman = skilled.game.allPlayers[0];
+    const Player& bowler = skilled.game.allPlayers[6];
+    double probabilities[NUM_OUTCOMES];
+    SkillModel::matchupDistribution(batsman, bowler, probabilities);
+    const int draws = 10000000;
+    long long counts[NUM_OUTCOMES] = {};
+    Rng rng(1);
+    for (int i = 0; i < draws; ++i) {
+        counts[skilled.game.skills.sample(batsman, bowler, rng)]++;
+    }
+    double maxError = 0.0;
+    for (int k = 0; k < NUM_OUTCOMES; ++k) {
+        maxError = std::max(maxError, std::abs(probabilities[k] - static_cast<double>(counts[k]) / draws));
+    }
+
+    double uniformRate = uniformResults.balls / std::chrono::duration<double>(middle - start).count();
+    double skilledRate = skilledResults.balls / std::chrono::duration<double>(end - middle).count();
+    std::cout << name << "\t" << uniformRate << "\t" << skilledRate << "\t" << skilledRate / uniformRate << "\t\t"
+              << skilled.game.skills.rebuilds() << "\t\t" << maxError << "\n";
+}
+
+// Times whole matches on the Game's one-batsman loop against the InningsEngine
+// (two batsmen, overs, bowler rotation, extras), in deliveries per second on one core
+void benchmarkInningsEngine(const char* name, int balls, int players, long long numMatches) {
+    Simulator loop;
+    loop.setFormat(balls, players);
+    SimulationResults loopResults = loop.makeResults();
+    auto start = std::chrono::steady_clock::now();
+    loop.runRange(0, numMatches, loopResults);
+    auto middle = std::chrono::steady_clock::now();
+
+    Simulator engine;
+    engine.setFormat(balls, players);
+    long long deliveries = 0;
+    long long extras = 0;
+    for (long long i = 0; i < numMatches; ++i) {
+        engine.setUpMatch(i);
+        for (int inningsNumber = 1; inningsNumber <= 2; ++inningsNumber) {
+            engine.innings.playInnings(engine.game, inningsNumber, [&deliveries, &extras](const BallEvent& ball) {
+                deliveries++;
+                extras += ball.extras;
+            });
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double loopRate = loopResults.balls / std::chrono::duration<double>(middle - start).count();
+    double engineRate = deliveries / std::chrono::duration<double>(end - middle).count();
+    std::cout << name << "\t" << loopRate << "\t" << engineRate << "\t\t" << engineRate / loopRate << "\t"
+              << static_cast<double>(deliveries) / numMatches / 2 << "\t\t"
+              << static_cast<double>(extras) / numMatches / 2 << "\n";
+}
+
+// Times saving and restoring a match state at delivery 'ball' against replaying
+// the match from the toss to the same ball, in nanoseconds per operation
+void benchmarkSnapshots(const char* name, int balls, int players, int ball, long long repeats) {
+    Simulator simulator;
+    simulator.setFormat(balls, players);
+    simulator.setUpMatch(0);
+    simulator.game.playDeliveries(ball);
+    MatchState state;
+    auto start = std::chrono::steady_clock::now();
+    long long checksum = 0;
+    for (long long i = 0; i < repeats; ++i) {
+        simulator.game.saveState(state);
+        checksum += state.rngState & 1;
+    }
+    auto saved = std::chrono::steady_clock::now();
+
+    MatchForker forker;
+    for (long long i = 0; i < repeats; ++i) {
+        forker.game.restoreState(state);
+        checksum += forker.game.currentBall;
+    }
+    auto restored = std::chrono::steady_clock::now();
+
+    Simulator replay;
+    replay.setFormat(balls, players);
+    for (long long i = 0; i < repeats; ++i) {
+        replay.setUpMatch(0);
+        checksum += replay.game.playDeliveries(ball);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    MatchState check;
+    replay.game.saveState(check);
+    double saveNs = std::chrono::duration<double, std::nano>(saved - start).count() / repeats;
+    double restoreNs = std::chrono::duration<double, std::nano>(restored - saved).count() / repeats;
+    double replayNs = std::chrono::duration<double, std::nano>(end - restored).count() / repeats;
+    std::cout << name << "\t" << ball << "\t" << saveNs << "\t" << restoreNs << "\t\t" << replayNs << "\t\t"
+              << replayNs / restoreNs << "\t"
+              << (std::memcmp(&check, &state, sizeof(MatchState)) == 0 && checksum != 0 ? "yes" : "NO") << "\n";
+}
+
+// Times the live win-probability lookup over every ball of 'numMatches' matches and
+// compares it with forking the match at a few balls (MatchForker, 'numForks' each)
+template <typename Format>
+void benchmarkWinProbability(const char* name, long long numMatches, long long numForks) {
+    struct BallState {
+        int inningsNum, ballsBowled, wicketsLost, runs, firstInningsRuns;
+    };
+    std::vector<BallState> states;
+    Simulator simulator;
+    simulator.setFormat(Format::balls, Format::players);
+    Game& game = simulator.game;
+    for (long long i = 0; i < numMatches; ++i) {
+        simulator.setUpMatch(i);
+        while (game.playDeliveries(1) == 1) {
+            BallState state = {game.inningsNum, game.battingTeam->totalBallsBowled,
+                               game.battingTeam->totalWicketsLost, game.battingTeam->totalRuns,
+                               game.bowlingTeam->totalRuns};
+            states.push_back(state);
+        }
+    }
+
+    WinPredictorFunction predict = findWinPredictor(Format::balls, Format::players);
+    auto start = std::chrono::steady_clock::now();
+    double checksum = 0;
+    for (const BallState& state : states) {
+        WinChance chance = predict(state.inningsNum, state.ballsBowled, state.wicketsLost, state.runs,
+                                   state.firstInningsRuns);
+        checksum += chance.batting;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    // Forks of match 0 at the toss and a quarter, half and three quarters of the way through
+    simulator.setUpMatch(0);
+    int length = game.playDeliveries(2 * Format::balls);
+    double maxError = 0;
+    MatchForker forker(1);
+    for (int ball : {0, length / 4, length / 2, 3 * length / 4}) {
+        simulator.setUpMatch(0);
+        game.winPredictor = predict;
+        game.playDeliveries(ball);
+        float teamAWins, teamBWins, draw;
+        MatchState state;
+        ForkOdds odds;
+        if (!game.winProbability(teamAWins, teamBWins, draw) || !game.saveState(state) ||
+            !forker.run(state, 0, numForks, odds)) {
+            continue;
+        }
+        maxError = std::max(maxError, std::fabs(teamAWins - static_cast<double>(odds.teamAWins) / odds.forks));
+        maxError = std::max(maxError, std::fabs(draw - static_cast<double>(odds.draws) / odds.forks));
+    }
+    game.winPredictor = nullptr;
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count() / states.size();
+    std::cout << name << "\t" << states.size() << "\t" << ns << "\t\t" << maxError
+              << (checksum > 0 ? "" : "\t(no balls)") << "\n";
+}
+
+// Times the sequential generator against the counter-based one, drawn one ball at a time
+// and in bulk, then whole matches of one format on each; the counter-based specialized
+// simulator must reproduce a Game using the counter-based generator exactly
+template <typename Format>
+void benchmarkCounterRng(const char* name, long long numMatches) {
+    const int balls = Format::balls;
+    long long draws = numMatches * balls;
+    uint64_t sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    Rng rng(1);
+    for (long long i = 0; i < draws; ++i) {
+        sum += rng.below(7);
+    }
+    auto sequential = std::chrono::steady_clock::now();
+    CounterRng counter(1);
+    for (long long match = 0; match < numMatches; ++match) {
+        for (int ball = 0; ball < balls; ++ball) {
+            sum += counter.below(7, match, 1, ball);
+        }
+    }
+    auto single = std::chrono::steady_clock::now();
+    std::vector<uint8_t> outcomes(balls);
+    for (long long match = 0; match < numMatches; ++match) {
+        counter.fillBelow(7, match, 1, 0, balls, outcomes.data());
+        sum += outcomes[balls - 1];
+    }
+    auto bulk = std::chrono::steady_clock::now();
+
+    long long formatMatches = std::max(1LL, numMatches / 4);
+    SimulationResults counterResults = runFormat<Format, true>(0, 1, formatMatches);
+    auto specialized = std::chrono::steady_clock::now();
+    Simulator generic;
+    generic.setFormat(balls, Format::players);
+    generic.game.enableCounterRng(0);
+    SimulationResults genericResults = generic.run(formatMatches);
+
+    double sequentialRate = draws / std::chrono::duration<double>(sequential - start).count();
+    double singleRate = draws / std::chrono::duration<double>(single - sequential).count();
+    double bulkRate = draws / std::chrono::duration<double>(bulk - single).count();
+    double matchRate = formatMatches / std::chrono::duration<double>(specialized - bulk).count();
+    std::cout << name << "\t" << sequentialRate << "\t" << singleRate << "\t" << bulkRate << "\t"
+              << matchRate << "\t\t" << (sameResults(counterResults, genericResults) && sum != 0 ? "yes" : "NO")
+              << "\n";
+}
+
+// Times the specialized simulator against the lockstep simulator on each kernel this
+// machine supports; every kernel must reproduce the specialized results exactly
+template <typename Format>
+void benchmarkLockstep(const char* name, long long numMatches) {
+    auto start = std::chrono::steady_clock::now();
+    SimulationResults reference = FormatSimulator<Format>().run(numMatches);
+    auto end = std::chrono::steady_clock::now();
+    double baseline = reference.balls / std::chrono::duration<double>(end - start).count();
+    std::cout << name << "\tspecialized\t" << baseline << "\t1\n";
+    for (LockstepKernel kernel : {LOCKSTEP_SCALAR, LOCKSTEP_AVX2, LOCKSTEP_AVX512}) {
+        if (!lockstepKernelSupported(kernel)) {
+            continue;
+        }
+        LockstepSimulator<Format> simulator;
+        simulator.kernel = kernel;
+        start = std::chrono::steady_clock::now();
+        SimulationResults results = simulator.run(numMatches);
+        end = std::chrono::steady_clock::now();
+        double rate = results.balls / std::chrono::duration<double>(end - start).count();
+        std::cout << name << "\t" << lockstepKernelName(kernel) << "\t\t" << rate << "\t" << rate / baseline << "\t"
+                  << (sameResults(reference, results) ? "yes" : "NO") << "\n";
+    }
+}
+
+// Runs league seasons on 1..maxThreads workers; every run must crown the same champions
+void benchmarkTournaments(long long numSeasons, int maxThreads) {
+    Game pool;
+    Tournament tournament(10, 6, 4, pool.allPlayers, 0);
+    std::cout << "Threads\tMatches per second\tPer thread\tSteals\tDeterministic\n";
+    TitleOdds baseline(0);
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        WorkStealingPool workers(threads);
+        auto start = std::chrono::steady_clock::now();
+        TitleOdds odds = tournament.simulateSeasons(workers, numSeasons, false);
+        auto end = std::chrono::steady_clock::now();
+        double rate = odds.matches / std::chrono::duration<double>(end - start).count();
+        if (threads == 1) {
+            baseline = odds;
+        }
+        std::cout << threads << "\t" << rate << "\t\t" << rate / threads << "\t\t" << workers.steals() << "\t"
+                  << (odds.titles == baseline.titles && odds.points == baseline.points ? "yes" : "NO") << "\n";
+    }
+}
+
+// --- Benchmark: headless match throughput ---
+int main(int argc, char* argv[]) {
+    long long numMatches = (argc > 1) ? atoll(argv[1]) : 2000000;
+    int maxThreads = (argc > 2) ? atoi(argv[2]) : static_cast<int>(std::thread::hardware_concurrency());
+    if (maxThreads < 1) {
+        maxThreads = 1;
+    }
+
+    Simulator simulator;
+    auto start = std::chrono::steady_clock::now();
+    SimulationResults results = simulator.run(numMatches);
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << "Single-threaded simulator\n";
+    std::cout << "Matches: " << results.matches << "\n";
+    std::cout << "Balls: " << results.balls << "\n";
+    std::cout << "Seconds: " << seconds << "\n";
+    std::cout << "Matches per second: " << results.matches / seconds << "\n";
+    std::cout << "Balls per second: " << results.balls / seconds << "\n\n";
+
+    // Thread scaling: every run must reproduce the single-threaded counts exactly
+    std::cout << "Threads\tBalls per second\tSpeedup\tDeterministic\n";
+    double baseline = 0;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        ParallelRunner<> runner(0, threads);
+        start = std::chrono::steady_clock::now();
+        SimulationResults parallel = runner.run(numMatches);
+        end = std::chrono::steady_clock::now();
+        double rate = parallel.balls / std::chrono::duration<double>(end - start).count();
+        if (threads == 1) {
+            baseline = rate;
+        }
+        std::cout << threads << "\t" << rate << "\t\t" << rate / baseline << "\t"
+                  << (sameResults(parallel, results) ? "yes" : "NO") << "\n";
+    }
+
+    // Compile-time formats (through the dispatch table) against the generic Game path
+    std::cout << "\nFormat\tGeneric balls/s\tSpecialized balls/s\tSpeedup\tIdentical\n";
+    for (const auto& format : formatTable()) {
+        long long formatMatches = std::max(1LL, numMatches * 6 / format.balls);
+        Simulator generic;
+        generic.setFormat(format.balls, format.players);
+        start = std::chrono::steady_clock::now();
+        SimulationResults genericResults = generic.run(formatMatches);
+        auto middle = std::chrono::steady_clock::now();
+        SimulationResults specializedResults = format.run(0, 1, formatMatches);
+        end = std::chrono::steady_clock::now();
+
+        double genericRate = genericResults.balls / std::chrono::duration<double>(middle - start).count();
+        double specializedRate = specializedResults.balls / std::chrono::duration<double>(end - middle).count();
+        std::cout << format.name << "\t" << genericRate << "\t" << specializedRate << "\t\t"
+                  << specializedRate / genericRate << "\t"
+                  << (sameResults(genericResults, specializedResults) ? "yes" : "NO") << "\n";
+    }
+
+    // Scorecard renderer: one frame per ball
+    std::cout << "\nScorecard\tFrames per second\n";
+    benchmarkRenderer("Full card", false, numMatches / 20);
+    benchmarkRenderer("In place", true, numMatches / 20);
+
+    // Pacing through the virtual clock
+    std::cout << "\n";
+    benchmarkInstantMatches(10000);
+
+    // Skill model: per-matchup alias tables against uniform 0-6
+    std::cout << "\nFormat\tUniform balls/s\tSkill balls/s\tRatio\tTables built\tMax |P - sampled|\n";
+    benchmarkSkills("one-over", 6, 4, numMatches);
+    benchmarkSkills("t20", 120, 11, numMatches / 20);
+
+    // Realistic innings engine against the Game loop
+    std::cout << "\nFormat\tLoop balls/s\tEngine deliveries/s\tRatio\tDeliveries/innings\tExtras/innings\n";
+    benchmarkInningsEngine("t20", 120, 11, numMatches / 20);
+    benchmarkInningsEngine("odi", 300, 11, numMatches / 50);
+
+    // Counter-based RNG: per ball and bulk against the sequential generator
+    std::cout << "\nCounter RNG (bulk fill " << (CounterRng::vectorized() ? "AVX2" : "scalar") << ")\n";
+    std::cout << "Format\tSequential draws/s\tCounter draws/s\tBulk draws/s\tMatches/s\tIdentical\n";
+    benchmarkCounterRng<OneOverFormat>("one-over", numMatches);
+    benchmarkCounterRng<T20Format>("t20", numMatches / 20);
+
+    // Lockstep kernels: eight matches per lane group against one match at a time
+    std::cout << "\nLockstep (" << LockstepSimulator<T20Format>::LANES << " matches per group)\n";
+    std::cout << "Format\tKernel\t\tBalls per second\tSpeedup\tIdentical\n";
+    benchmarkLockstep<OneOverFormat>("one-over", numMatches);
+    benchmarkLockstep<T20Format>("t20", numMatches / 20);
+    benchmarkLockstep<OdiFormat>("odi", numMatches / 50);
+
+    // Match snapshots: save and restore against replaying from the toss
+    std::cout << "\nFormat\tBall\tSave ns\tRestore ns\tReplay ns\tSpeedup\tIdentical\n";
+    benchmarkSnapshots("one-over", 6, 4, 9, numMatches);
+    benchmarkSnapshots("t20", 120, 11, 180, numMatches / 20);
+
+    // Live win probability: per-ball lookup cost and agreement with forked matches
+    std::cout << "\nFormat\tBalls\tNs per ball\tMax |P - forks|\n";
+    benchmarkWinProbability<OneOverFormat>("one-over", numMatches / 20, 100000);
+    benchmarkWinProbability<T20Format>("t20", numMatches / 400, 100000);
+    benchmarkWinProbability<OdiFormat>("odi", numMatches / 1000, 20000);
+
+    // League seasons on the work-stealing pool
+    std::cout << "\nTournament: 10-team league, " << numMatches / 45 << " seasons\n";
+    benchmarkTournaments(numMatches / 45, maxThreads);
+
+    // Exact engine: table build and query cost, cross-validated against simulation
+    std::cout << "\nFormat\tBuild ms\tQuery ns\tMax |P - sim| innings 1\tChase win exact/sim\tDraw exact/sim\n";
+    crossValidate<OneOverFormat>("one-over", numMatches);
+    crossValidate<T20Format>("t20", numMatches / 10);
+    crossValidate<OdiFormat>("odi", numMatches / 50);
+    return 0;
+}
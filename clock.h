@@ -0,0 +1,60 @@
+#ifndef CRICKET_CLOCK_H
+#define CRICKET_CLOCK_H
+
+#include <chrono>
+#include <thread>
+
+// --- Clock Class Definition ---
+// Virtual clock that all game pacing goes through. Pauses advance virtual
+// time; how much real time that takes depends on the mode: real time,
+// scaled (e.g. 10x faster) or instant (no waiting, for tests and batch runs).
+class Clock {
+public:
+    enum Mode {
+        REAL_TIME,
+        SCALED,
+        INSTANT
+    };
+
+    Mode mode;
+    double speed;        // Virtual seconds per real second
+    long long nowMicros; // Virtual time elapsed so far
+
+    // Constructor
+    Clock(Mode mode = REAL_TIME, double speed = 1.0) :
+        mode(mode),
+        speed(speed > 0 ? speed : 1.0),
+        nowMicros(0) {}
+
+    static Clock realTime() {
+        return Clock(REAL_TIME, 1.0);
+    }
+
+    static Clock scaled(double speed) {
+        return Clock(SCALED, speed);
+    }
+
+    static Clock instant() {
+        return Clock(INSTANT, 1.0);
+    }
+
+    // Waits 'micros' of virtual time
+    void pause(long long micros) {
+        sleepUntil(nowMicros + micros);
+    }
+
+    // Waits until virtual time reaches 'virtualMicros' (no-op if it already has)
+    void sleepUntil(long long virtualMicros) {
+        if (virtualMicros <= nowMicros) {
+            return;
+        }
+        long long delta = virtualMicros - nowMicros;
+        nowMicros = virtualMicros;
+        if (mode == INSTANT) {
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(static_cast<long long>(delta / speed)));
+    }
+};
+
+#endif // CRICKET_CLOCK_H
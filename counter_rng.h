@@ -0,0 +1,197 @@
+#ifndef CRICKET_COUNTER_RNG_H
+#define CRICKET_COUNTER_RNG_H
+
+#include <cstdint>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CRICKET_COUNTER_RNG_AVX2 1
+#endif
+
+// --- CounterRng Class Definition ---
+// Counter-based generator (Philox4x32-10): the random bits of a draw are a
+// pure function of the seed and the draw's address, (match, innings, ball),
+// so any delivery of any match can be reproduced in O(1) without replaying
+// a stream, and whole innings can be generated in parallel. Innings 0 is the
+// toss. One Philox block gives four 32-bit words per address; bounded draws
+// take them in order (Lemire's method, rejecting the few biased values) and
+// move on to the address's next block in the astronomically rare case all
+// four are rejected.
+class CounterRng {
+public:
+    uint64_t seed;
+
+    // Constructor
+    explicit CounterRng(uint64_t seed = 0) : seed(seed) {}
+
+    // Four random words for block 'block' of address (match, innings, ball)
+    struct Block {
+        uint32_t words[4];
+    };
+
+    Block block(uint64_t match, int innings, int ball, uint32_t blockIndex = 0) const {
+        uint32_t c[4] = {static_cast<uint32_t>(ball), counterWord1(innings, blockIndex),
+                         static_cast<uint32_t>(match), static_cast<uint32_t>(match >> 32)};
+        uint32_t key[2] = {static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)};
+        for (int round = 0; round < ROUNDS; ++round) {
+            uint64_t product0 = static_cast<uint64_t>(M0) * c[0];
+            uint64_t product1 = static_cast<uint64_t>(M1) * c[2];
+            uint32_t next[4] = {static_cast<uint32_t>(product1 >> 32) ^ c[1] ^ key[0], static_cast<uint32_t>(product1),
+                                static_cast<uint32_t>(product0 >> 32) ^ c[3] ^ key[1], static_cast<uint32_t>(product0)};
+            c[0] = next[0];
+            c[1] = next[1];
+            c[2] = next[2];
+            c[3] = next[3];
+            key[0] += W0;
+            key[1] += W1;
+        }
+        Block result = {{c[0], c[1], c[2], c[3]}};
+        return result;
+    }
+
+    // --- Cursor: the bounded draws of one address, in order ---
+    class Cursor {
+    public:
+        Cursor(const CounterRng& rng, uint64_t match, int innings, int ball) :
+            rng(rng), match(match), innings(innings), ball(ball), blockIndex(0), used(0),
+            bits(rng.block(match, innings, ball)) {}
+
+        // Next 32 random bits of the address
+        uint32_t next() {
+            if (used == 4) {
+                bits = rng.block(match, innings, ball, ++blockIndex);
+                used = 0;
+            }
+            return bits.words[used++];
+        }
+
+        // A uniform integer in [0, bound) without modulo bias (Lemire's method)
+        uint32_t below(uint32_t bound) {
+            uint64_t product = static_cast<uint64_t>(next()) * bound;
+            uint32_t low = static_cast<uint32_t>(product);
+            if (low < bound) {
+                uint32_t threshold = -bound % bound;
+                while (low < threshold) {
+                    product = static_cast<uint64_t>(next()) * bound;
+                    low = static_cast<uint32_t>(product);
+                }
+            }
+            return static_cast<uint32_t>(product >> 32);
+        }
+
+    private:
+        const CounterRng& rng;
+        uint64_t match;
+        int innings;
+        int ball;
+        uint32_t blockIndex;
+        int used;
+        Block bits;
+    };
+
+    // Draws of address (match, innings, ball)
+    Cursor at(uint64_t match, int innings, int ball) const {
+        return Cursor(*this, match, innings, ball);
+    }
+
+    // The first bounded draw of an address: what one delivery uses
+    uint32_t below(uint32_t bound, uint64_t match, int innings, int ball) const {
+        return at(match, innings, ball).below(bound);
+    }
+
+    // Fills out[i] with below(bound, match, innings, firstBall + i) for 'count' balls:
+    // eight balls per Philox evaluation with AVX2 where the CPU has it, one at a time
+    // otherwise; the results are the same either way
+    void fillBelow(uint32_t bound, uint64_t match, int innings, int firstBall, int count, uint8_t* out) const {
+        int done = 0;
+#ifdef CRICKET_COUNTER_RNG_AVX2
+        if (hasAvx2()) {
+            done = fillBelowAvx2(bound, match, innings, firstBall, count, out);
+        }
+#endif
+        for (int i = done; i < count; ++i) {
+            out[i] = static_cast<uint8_t>(below(bound, match, innings, firstBall + i));
+        }
+    }
+
+    // True if fillBelow() runs eight lanes at a time on this machine
+    static bool vectorized() {
+#ifdef CRICKET_COUNTER_RNG_AVX2
+        return hasAvx2();
+#else
+        return false;
+#endif
+    }
+
+private:
+    static const int ROUNDS = 10;
+    static const uint32_t M0 = 0xD2511F53;
+    static const uint32_t M1 = 0xCD9E8D57;
+    static const uint32_t W0 = 0x9E3779B9;
+    static const uint32_t W1 = 0xBB67AE85;
+
+    static uint32_t counterWord1(int innings, uint32_t blockIndex) {
+        return static_cast<uint32_t>(innings) | (blockIndex << 8);
+    }
+
+#ifdef CRICKET_COUNTER_RNG_AVX2
+    static bool hasAvx2() {
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+    }
+
+    // High and low 32 bits of the eight products a[i] * m
+    __attribute__((target("avx2"))) static void mulHiLo(__m256i a, __m256i m, __m256i& hi, __m256i& lo) {
+        __m256i even = _mm256_mul_epu32(a, m);                                         // Lanes 0, 2, 4, 6
+        __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(m, 32)); // Lanes 1, 3, 5, 7
+        lo = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+        hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+    }
+
+    // Whole groups of eight balls of fillBelow(); returns how many balls it filled
+    __attribute__((target("avx2"))) int fillBelowAvx2(uint32_t bound, uint64_t match, int innings, int firstBall,
+                                                      int count, uint8_t* out) const {
+        const uint32_t threshold = -bound % bound;
+        const __m256i m0 = _mm256_set1_epi32(static_cast<int>(M0));
+        const __m256i m1 = _mm256_set1_epi32(static_cast<int>(M1));
+        const __m256i boundVector = _mm256_set1_epi32(static_cast<int>(bound));
+        const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i signBit = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+        const __m256i thresholdVector = _mm256_set1_epi32(static_cast<int>(threshold ^ 0x80000000u));
+        int done = 0;
+        for (; done + 8 <= count; done += 8) {
+            __m256i c0 = _mm256_add_epi32(_mm256_set1_epi32(firstBall + done), lanes);
+            __m256i c1 = _mm256_set1_epi32(static_cast<int>(counterWord1(innings, 0)));
+            __m256i c2 = _mm256_set1_epi32(static_cast<int>(static_cast<uint32_t>(match)));
+            __m256i c3 = _mm256_set1_epi32(static_cast<int>(static_cast<uint32_t>(match >> 32)));
+            uint32_t key0 = static_cast<uint32_t>(seed);
+            uint32_t key1 = static_cast<uint32_t>(seed >> 32);
+            for (int round = 0; round < ROUNDS; ++round) {
+                __m256i hi0, lo0, hi1, lo1;
+                mulHiLo(c0, m0, hi0, lo0);
+                mulHiLo(c2, m1, hi1, lo1);
+                c0 = _mm256_xor_si256(_mm256_xor_si256(hi1, c1), _mm256_set1_epi32(static_cast<int>(key0)));
+                c1 = lo1;
+                c2 = _mm256_xor_si256(_mm256_xor_si256(hi0, c3), _mm256_set1_epi32(static_cast<int>(key1)));
+                c3 = lo0;
+                key0 += W0;
+                key1 += W1;
+            }
+
+            // Word 0 of each block through Lemire's method; lanes it would reject redo the scalar path
+            __m256i hi, lo;
+            mulHiLo(c0, boundVector, hi, lo);
+            __m256i rejected = _mm256_cmpgt_epi32(thresholdVector, _mm256_xor_si256(lo, signBit)); // lo < threshold
+            alignas(32) uint32_t values[8];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(values), hi);
+            int rejectMask = _mm256_movemask_ps(_mm256_castsi256_ps(rejected));
+            for (int lane = 0; lane < 8; ++lane) {
+                out[done + lane] = static_cast<uint8_t>(
+                    (rejectMask >> lane) & 1 ? below(bound, match, innings, firstBall + done + lane) : values[lane]);
+            }
+        }
+        return done;
+    }
+#endif
+};
+
+#endif // CRICKET_COUNTER_RNG_H
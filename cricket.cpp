@@ -1,503 +1,439 @@
-#include <iostream>
-#include <string>
-#include <vector>
-#include <limits>   // Required for numeric_limits
-#include <algorithm> // Required for std::find
-#include <cstdlib>  // For rand() and srand()
-#include <ctime>    // For time()
-#include <unistd.h> // For usleep() (Note: For Windows, you might use <windows.h> and Sleep() instead)
-
-// --- Player Class Definition ---
-class Player {
-public:
-    std::string name;
-    int id;
-    int runsScored;
-    int ballsPlayed;
-    int ballsBowled;
-    int runsGiven;
-    int wicketsTaken;
-    bool isOut;
-
-    // Constructor
-    Player(std::string name, int id) :
-        name(name),
-        id(id),
-        runsScored(0),
-        ballsPlayed(0),
-        ballsBowled(0),
-        runsGiven(0),
-        wicketsTaken(0),
-        isOut(false) {}
-
-    // Displays player's current stats
-    void displayStats() const {
-        std::cout << "\t" << name
-                  << "\t\tRuns: " << runsScored
-                  << "\tBalls: " << ballsPlayed
-                  << "\tWickets: " << wicketsTaken
-                  << "\tRuns Given: " << runsGiven
-                  << "\n";
-    }
-};
-
-// --- Team Class Definition ---
-class Team {
-public:
-    std::string name;
-    std::vector<Player> players; // List of players in the team
-    int totalRuns;
-    int totalWicketsLost;
-    int totalBallsBowled;
-
-    // Constructor
-    Team(std::string name) :
-        name(name),
-        totalRuns(0),
-        totalWicketsLost(0),
-        totalBallsBowled(0) {}
-
-    // Adds a player to the team
-    void addPlayer(const Player& player) {
-        players.push_back(player);
-    }
-
-    // Displays all players in the team
-    void displayTeamPlayers() const {
-        std::cout << "\t" << name << " Players:\n";
-        for (const auto& player : players) {
-            std::cout << "\t\t" << player.name << "\n";
-        }
-        std::cout << "\n";
-    }
-};
-
-// --- Game Class Definition ---
-class Game {
-public:
-    Team teamA;
-    Team teamB;
-    int playersPerTeam;
-    int maxDeliveries;
-    int inningsNum;
-
-    // Pointers for current game state
-    Team* battingTeam;
-    Team* bowlingTeam;
-    Player* currentBatsman;
-    Player* currentBowler;
-
-    std::vector<Player> allPlayers; // Pool of all 11 players
-    std::vector<int> selectedPlayerIds; // To keep track of selected player IDs
-
-    // Constructor
-    Game() :
-        teamA("TeamA"),
-        teamB("TeamB"),
-        playersPerTeam(4),
-        maxDeliveries(6),
-        inningsNum(0),
-        battingTeam(nullptr),
-        bowlingTeam(nullptr),
-        currentBatsman(nullptr),
-        currentBowler(nullptr)
-    {
-        // Initialize the pool of 11 players
-        allPlayers.push_back(Player("Virat", 1));
-        allPlayers.push_back(Player("Rohit", 2));
-        allPlayers.push_back(Player("Dhawan", 3));
-        allPlayers.push_back(Player("Rahul", 4));
-        allPlayers.push_back(Player("Hardik", 5));
-        allPlayers.push_back(Player("Jadeja", 6));
-        allPlayers.push_back(Player("Bumrah", 7));
-        allPlayers.push_back(Player("Shami", 8));
-        allPlayers.push_back(Player("Yuzvendra", 9));
-        allPlayers.push_back(Player("Kuldeep", 10));
-        allPlayers.push_back(Player("Rishabh", 11));
-
-        // Seed the random number generator
-        srand(time(0));
-    }
-
-    // Displays welcome message and instructions
-    void welcome() {
-        std::cout << "\n\n\t\t----------------------------------------\n";
-        std::cout << "\t\t|        WELCOME TO CRICKET GAME!      |\n";
-        std::cout << "\t\t----------------------------------------\n\n";
-
-        std::cout << "Instructions:\n";
-        std::cout << "1. Two teams (TeamA and TeamB) will play.\n";
-        std::cout << "2. Each team will have " << playersPerTeam << " players selected by you.\n";
-        std::cout << "3. Each innings will be of " << maxDeliveries << " balls.\n";
-        std::cout << "4. If a batsman scores 0 runs in a delivery, they are OUT.\n";
-        std::cout << "5. The team with more runs wins. If scores are tied, it's a DRAW.\n\n";
-
-        usleep(3000000); // 3 seconds pause
-    }
-
-    // Displays the pool of 11 players
-    void displayAllPlayers() const {
-        std::cout << "\t----------------------------------\n";
-        std::cout << "\t|         Pool of Players        |\n";
-        std::cout << "\t----------------------------------\n";
-        for (const auto& player : allPlayers) {
-            std::cout << "\t" << player.id << ". " << player.name << "\n";
-        }
-        std::cout << "\t----------------------------------\n\n";
-        usleep(2000000); // 2 seconds pause
-    }
-
-    // Utility to take safe integer input
-    int takeIntegerInput() {
-        int choice;
-        while (!(std::cin >> choice)) {
-            std::cout << "\tInvalid input. Please enter a number: ";
-            std::cin.clear(); // Clear error flags
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // Discard invalid input
-        }
-        return choice;
-    }
-
-    // Validates if player is already selected or if ID is valid
-    bool checkPlayerSelection(int playerId) {
-        // Check if player ID is valid (1-11)
-        if (playerId < 1 || playerId > allPlayers.size()) {
-            return false;
-        }
-
-        // Check if player is already selected
-        for (int selectedId : selectedPlayerIds) {
-            if (selectedId == playerId) {
-                return false;
-            }
-        }
-        return true; // Player is valid and not yet selected
-    }
-
-    // Allows user to select players for both teams
-    void selectPlayers() {
-        std::cout << "\t----------------------------------\n";
-        std::cout << "\t|         Team Selection         |\n";
-        std::cout << "\t----------------------------------\n";
-
-        // Select players for TeamA
-        std::cout << "\tSelect " << playersPerTeam << " players for TeamA:\n";
-        for (int i = 0; i < playersPerTeam; ++i) {
-            int playerId;
-            while (true) {
-                std::cout << "\tPlayer " << (i + 1) << " (TeamA) - Enter player ID: ";
-                playerId = takeIntegerInput();
-                if (checkPlayerSelection(playerId)) {
-                    teamA.addPlayer(allPlayers[playerId - 1]); // Add selected player to TeamA
-                    selectedPlayerIds.push_back(playerId);     // Mark as selected
-                    std::cout << "\t" << allPlayers[playerId - 1].name << " added to TeamA.\n";
-                    break;
-                } else {
-                    std::cout << "\tInvalid selection! Player ID must be between 1-" << allPlayers.size() << " and not already selected. Try again.\n";
-                }
-            }
-        }
-        std::cout << "\n";
-        usleep(1000000); // 1 second pause
-
-        // Select players for TeamB
-        std::cout << "\tSelect " << playersPerTeam << " players for TeamB:\n";
-        for (int i = 0; i < playersPerTeam; ++i) {
-            int playerId;
-            while (true) {
-                std::cout << "\tPlayer " << (i + 1) << " (TeamB) - Enter player ID: ";
-                playerId = takeIntegerInput();
-                if (checkPlayerSelection(playerId)) {
-                    teamB.addPlayer(allPlayers[playerId - 1]); // Add selected player to TeamB
-                    selectedPlayerIds.push_back(playerId);     // Mark as selected
-                    std::cout << "\t" << allPlayers[playerId - 1].name << " added to TeamB.\n";
-                    break;
-                } else {
-                    std::cout << "\tInvalid selection! Player ID must be between 1-" << allPlayers.size() << " and not already selected. Try again.\n";
-                }
-            }
-        }
-        std::cout << "\n";
-        usleep(1000000); // 1 second pause
-
-        // Display selected teams
-        teamA.displayTeamPlayers();
-        teamB.displayTeamPlayers();
-        usleep(2000000); // 2 seconds pause
-    }
-
-    // Handles the toss functionality
-    void toss() {
-        std::cout << "\t----------------------------------\n";
-        std::cout << "\t|          TOSS TIME!            |\n";
-        std::cout << "\t----------------------------------\n";
-
-        std::cout << "\tPress 1 for TeamA or 2 for TeamB to call (Heads/Tails):\n";
-        std::cout << "\t(Any number other than 1 or 2 will be considered random choice)\n";
-        int call = takeIntegerInput();
-        std::cout << "\n";
-
-        // Simulate toss: 0 for heads, 1 for tails
-        int tossResult = rand() % 2; // 0 or 1
-
-        std::string winningTeamName;
-        bool teamAWonToss = false;
-
-        // Determine which team won the toss based on call and result
-        if ((tossResult == 0 && call == 1) || (tossResult == 1 && call == 2)) {
-            winningTeamName = (call == 1) ? teamA.name : teamB.name;
-            teamAWonToss = (call == 1);
-        } else {
-            // Random winner or incorrect call
-            if (tossResult == 0) { // Heads
-                winningTeamName = teamA.name;
-                teamAWonToss = true;
-            } else { // Tails
-                winningTeamName = teamB.name;
-                teamAWonToss = false;
-            }
-        }
-
-        std::cout << "\tIt's " << (tossResult == 0 ? "Heads" : "Tails") << "! Team " << winningTeamName << " wins the toss!\n";
-        usleep(2000000); // 2 seconds pause
-
-        std::cout << "\t" << winningTeamName << ", what do you choose?\n";
-        std::cout << "\t1. Bat\n";
-        std::cout << "\t2. Bowl\n";
-        int choice = takeIntegerInput();
-
-        if (teamAWonToss) {
-            if (choice == 1) { // TeamA bats
-                battingTeam = &teamA;
-                bowlingTeam = &teamB;
-            } else { // TeamA bowls
-                battingTeam = &teamB;
-                bowlingTeam = &teamA;
-            }
-        } else { // TeamB won toss
-            if (choice == 1) { // TeamB bats
-                battingTeam = &teamB;
-                bowlingTeam = &teamA;
-            } else { // TeamB bowls
-                battingTeam = &teamA;
-                bowlingTeam = &teamB;
-            }
-        }
-
-        std::cout << "\t" << battingTeam->name << " will bat first and " << bowlingTeam->name << " will bowl first.\n\n";
-        usleep(3000000); // 3 seconds pause
-    }
-
-    // Starts an innings
-    void startInnings(int inningsNumber) {
-        inningsNum = inningsNumber;
-        std::cout << "\t----------------------------------\n";
-        std::cout << "\t|         INNINGS " << inningsNum << " BEGINS         |\n";
-        std::cout << "\t----------------------------------\n\n";
-        usleep(2000000); // 2 seconds pause
-
-        // Swap batting and bowling teams for the second innings
-        if (inningsNum == 2) {
-            Team* temp = battingTeam;
-            battingTeam = bowlingTeam;
-            bowlingTeam = temp;
-
-            // Reset player states for the new innings (especially isOut)
-            for (auto& player : teamA.players) {
-                player.isOut = false;
-            }
-            for (auto& player : teamB.players) {
-                player.isOut = false;
-            }
-        }
-
-        // Initialize batsman and bowler for the innings
-        int batsmanIndex = 0;
-        while (batsmanIndex < battingTeam->players.size() && battingTeam->players[batsmanIndex].isOut) {
-            batsmanIndex++; // Find the first not-out batsman
-        }
-        currentBatsman = (batsmanIndex < battingTeam->players.size()) ? &battingTeam->players[batsmanIndex] : nullptr;
-
-        currentBowler = &bowlingTeam->players[0]; // First player to bowl
-
-        std::cout << "\t" << battingTeam->name << " is batting.\n";
-        std::cout << "\t" << bowlingTeam->name << " is bowling.\n";
-
-        if (currentBatsman) {
-            std::cout << "\t" << currentBatsman->name << " is on strike.\n";
-        } else {
-            std::cout << "\tAll batsmen are out for " << battingTeam->name << "!\n";
-        }
-        std::cout << "\t" << currentBowler->name << " is bowling.\n\n";
-
-        usleep(3000000); // 3 seconds pause
-        playInnings(); // Start playing the current innings
-    }
-
-    // Plays one innings
-    void playInnings() {
-        int currentBall = 0;
-        int batsmanIndex = 0;
-
-        // Find the starting batsman
-        while (batsmanIndex < battingTeam->players.size() && battingTeam->players[batsmanIndex].isOut) {
-            batsmanIndex++;
-        }
-        if (batsmanIndex < battingTeam->players.size()) {
-            currentBatsman = &battingTeam->players[batsmanIndex];
-        } else {
-            // All batsmen already out (shouldn't happen at start of innings 1, but for innings 2 it's possible)
-            std::cout << "\tNo batsmen left to bat for " << battingTeam->name << ".\n";
-            return;
-        }
-
-        // The first bowler always bowls all 6 deliveries
-        currentBowler = &bowlingTeam->players[0];
-
-        while (currentBall < maxDeliveries && battingTeam->totalWicketsLost < playersPerTeam) {
-            std::cout << "\t" << currentBatsman->name << " on strike. " << currentBowler->name << " bowling.\n";
-            std::cout << "\tBall " << (currentBall + 1) << " of " << maxDeliveries << "...\n";
-            usleep(1500000); // 1.5 seconds pause
-
-            // Simulate runs (0-6)
-            int runsScored = rand() % 7; // Generates 0 to 6
-
-            std::cout << "\t" << currentBatsman->name << " scores " << runsScored << " runs!\n";
-            usleep(1000000); // 1 second pause
-
-            // Update player and team stats
-            currentBatsman->runsScored += runsScored;
-            currentBatsman->ballsPlayed++;
-            battingTeam->totalRuns += runsScored;
-
-            currentBowler->ballsBowled++;
-            currentBowler->runsGiven += runsScored;
-
-            // Update balls bowled for the batting team's innings, and for the bowling team's overall stats
-            battingTeam->totalBallsBowled++;
-            // Note: Bowling team's totalBallsBowled increments each ball across both innings
-            // If you want per-innings, you'd need to reset it, but problem implies cumulative for bowler.
-
-            // Check for OUT criteria (0 runs)
-            if (runsScored == 0) {
-                currentBatsman->isOut = true;
-                battingTeam->totalWicketsLost++;
-                currentBowler->wicketsTaken++;
-                std::cout << "\t" << currentBatsman->name << " is OUT!\n";
-                usleep(1500000); // 1.5 seconds pause
-
-                // Move to next batsman if available and not out
-                batsmanIndex++;
-                while (batsmanIndex < battingTeam->players.size() && battingTeam->players[batsmanIndex].isOut) {
-                    batsmanIndex++;
-                }
-
-                if (batsmanIndex < battingTeam->players.size()) {
-                    currentBatsman = &battingTeam->players[batsmanIndex];
-                    std::cout << "\tNext batsman: " << currentBatsman->name << "\n";
-                    usleep(1500000); // 1.5 seconds pause
-                } else {
-                    std::cout << "\tAll batsmen are out for " << battingTeam->name << "!\n";
-                    usleep(1500000);
-                }
-            }
-            currentBall++;
-            displayScoreCard();
-            usleep(2000000); // 2 seconds pause
-
-            // Check if innings is over based on runs, wickets, or balls
-            if (inningsNum == 2) {
-                // In second innings, check if target is reached or wickets/balls are finished
-                if (battingTeam->totalRuns > bowlingTeam->totalRuns || // Target chased
-                    currentBall == maxDeliveries ||                      // Overs finished
-                    battingTeam->totalWicketsLost == playersPerTeam) {   // All out
-                    break; // End innings
-                }
-            } else { // First innings
-                if (currentBall == maxDeliveries ||                      // Overs finished
-                    battingTeam->totalWicketsLost == playersPerTeam) {   // All out
-                    break; // End innings
-                }
-            }
-        }
-        std::cout << "\t----------------------------------\n";
-        std::cout << "\t|         INNINGS " << inningsNum << " OVER!         |\n";
-        std::cout << "\t----------------------------------\n\n";
-        usleep(2000000); // 2 seconds pause
-    }
-
-    // Displays the current game scorecard
-    void displayScoreCard() const {
-        std::cout << "\n\t----------------------------------\n";
-        std::cout << "\t|         SCORECARD              |\n";
-        std::cout << "\t----------------------------------\n";
-        std::cout << "\t" << teamA.name << " Score: " << teamA.totalRuns << "/" << teamA.totalWicketsLost << "\tBalls: " << teamA.totalBallsBowled << "/" << maxDeliveries << "\n";
-        std::cout << "\t" << teamB.name << " Score: " << teamB.totalRuns << "/" << teamB.totalWicketsLost << "\tBalls: " << teamB.totalBallsBowled << "/" << maxDeliveries << "\n";
-
-        // Display target if it's the second innings
-        if (inningsNum == 2) {
-            std::cout << "\tTarget for " << battingTeam->name << ": " << (bowlingTeam->totalRuns + 1) << " runs.\n";
-            std::cout << "\t" << battingTeam->name << " needs " << ((bowlingTeam->totalRuns + 1) - battingTeam->totalRuns) << " runs to win.\n";
-        }
-
-        std::cout << "\n\tBatsman Stats (" << teamA.name << "):\n";
-        std::cout << "\t---------------\n";
-        for (const auto& player : teamA.players) {
-            player.displayStats();
-        }
-        std::cout << "\n\tBatsman Stats (" << teamB.name << "):\n";
-        std::cout << "\t---------------\n";
-        for (const auto& player : teamB.players) {
-            player.displayStats();
-        }
-        std::cout << "\t----------------------------------\n\n";
-    }
-
-    // Displays the match summary at the end
-    void displayMatchSummary() const {
-        std::cout << "\n\n\t----------------------------------------\n";
-        std::cout << "\t|           MATCH SUMMARY              |\n";
-        std::cout << "\t----------------------------------------\n";
-        displayScoreCard(); // Show final scorecard
-
-        std::cout << "\tFinal Scores:\n";
-        std::cout << "\t" << teamA.name << ": " << teamA.totalRuns << "/" << teamA.totalWicketsLost << " (" << teamA.totalBallsBowled << " balls)\n";
-        std::cout << "\t" << teamB.name << ": " << teamB.totalRuns << "/" << teamB.totalWicketsLost << " (" << teamB.totalBallsBowled << " balls)\n\n";
-
-        if (teamA.totalRuns > teamB.totalRuns) {
-            std::cout << "\t----------------------------------\n";
-            std::cout << "\t|          TEAM A WINS!          |\n";
-            std::cout << "\t----------------------------------\n\n";
-        } else if (teamB.totalRuns > teamA.totalRuns) {
-            std::cout << "\t----------------------------------\n";
-            std::cout << "\t|          TEAM B WINS!          |\n";
-            std::cout << "\t----------------------------------\n\n";
-        } else {
-            std::cout << "\t----------------------------------\n";
-            std::cout << "\t|          MATCH DRAW!           |\n";
-            std::cout << "\t----------------------------------\n\n";
-        }
-
-        std::cout << "\tThank you for playing!\n\n";
-    }
-};
-
-// --- Main Function ---
-int main() {
-    Game game; // Create a Game object
-
-    game.welcome();           // Display welcome message and instructions
-    game.displayAllPlayers(); // Show the pool of available players
-    game.selectPlayers();     // Allow user to select players for teams
-    game.toss();              // Perform the toss and decide batting/bowling order
-
-    // First Innings
-    game.startInnings(1); // Start and play the first innings
-
-    // Second Innings
-    game.startInnings(2); // Start and play the second innings
-
-    game.displayMatchSummary(); // Display the final match summary
-
-    return 0;
-}
\ No newline at end of file
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <cstdlib>  // For atoll(), atof() and strtoull()
+#include <fstream>
+#include <memory>
+#include <vector>
+#include "clock.h"
+#include "event_loop.h"
+#include "game.h"
+#include "parallel_runner.h"
+#include "match_fork.h"
+#include "match_format.h"
+#include "live_server.h"
+#include "lockstep_simulator.h"
+#include "match_spec.h"
+#include "probability.h"
+#include "tournament.h"
+#include "win_probability.h"
+
+// Pacing from the command line: --speed X (X times faster than real time) or --instant
+Clock clockFromArgs(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        std::string option = argv[i];
+        if (option == "--instant") {
+            return Clock::instant();
+        }
+        if (option == "--speed" && i + 1 < argc) {
+            return Clock::scaled(atof(argv[i + 1]));
+        }
+    }
+    return Clock::realTime();
+}
+
+// With --profile, writes the phase counters to stderr (they are all zero unless built with CRICKET_PROFILE)
+void printProfile(bool profile) {
+    if (!profile) {
+        return;
+    }
+    if (!Profiler::enabled()) {
+        std::cerr << "Phase counters are compiled out; rebuild with -DCRICKET_PROFILE=ON.\n";
+    }
+    Profiler::writeJson(std::cerr);
+    std::cerr << "\n";
+}
+
+// --- Main Function ---
+int main(int argc, char* argv[]) {
+    // Headless mode: ./cricket_game --simulate N [--seed S] [--threads T] [--format F] [--log FILE]
+    // [--skills | --realistic | --counter-rng | --lockstep] [--profile] prints only aggregate results (with
+    // --log, writes every delivery to a binary event log; with --skills, draws every ball from the players'
+    // skill profiles instead of uniform 0-6; with --realistic, plays innings with two batsmen, overs, bowler
+    // rotation and extras; with --counter-rng, draws the toss and balls from the counter-based generator,
+    // addressed by match, innings and ball; with --lockstep, plays eight matches at a time on the SIMD
+    // lockstep kernel, with the same results; with --profile, writes the phase counters of a CRICKET_PROFILE
+    // build to stderr as JSON)
+    if (argc > 1 && std::string(argv[1]) == "--simulate") {
+        long long numMatches = (argc > 2) ? atoll(argv[2]) : 1000000;
+        uint64_t seed = 0;
+        int threads = 0;
+        std::string formatName = "one-over";
+        std::string logPath;
+        SimulationModel model = UNIFORM_MODEL;
+        bool profile = false;
+        bool counterRng = false;
+        bool lockstep = false;
+        for (int i = 3; i < argc; ++i) {
+            std::string option = argv[i];
+            if (option == "--profile") {
+                profile = true;
+            } else if (option == "--counter-rng") {
+                counterRng = true;
+            } else if (option == "--lockstep") {
+                lockstep = true;
+            } else if (option == "--skills") {
+                model = SKILL_MODEL;
+            } else if (option == "--realistic") {
+                model = REALISTIC_MODEL;
+            } else if (i + 1 < argc && option == "--seed") {
+                seed = strtoull(argv[++i], nullptr, 10);
+            } else if (i + 1 < argc && option == "--threads") {
+                threads = atoi(argv[++i]);
+            } else if (i + 1 < argc && option == "--format") {
+                formatName = argv[++i];
+            } else if (i + 1 < argc && option == "--log") {
+                logPath = argv[++i];
+            }
+        }
+        const FormatEntry* format = findFormat(formatName);
+        if (format == nullptr) {
+            std::cerr << "Unknown format '" << formatName << "'. Available formats:";
+            for (const auto& entry : formatTable()) {
+                std::cerr << " " << entry.name;
+            }
+            std::cerr << "\n";
+            return 1;
+        }
+        if (counterRng && model != UNIFORM_MODEL) {
+            std::cerr << "The counter-based generator draws uniform balls only (no --skills or --realistic).\n";
+            return 1;
+        }
+        if (lockstep && (model != UNIFORM_MODEL || counterRng || !logPath.empty())) {
+            std::cerr << "The lockstep kernel plays uniform balls on the default generator, without a log "
+                         "(no --skills, --realistic, --counter-rng or --log).\n";
+            return 1;
+        }
+        if (!logPath.empty() && model == REALISTIC_MODEL) {
+            std::cerr << "Realistic innings (extras, non-strikers) cannot be written to an event log.\n";
+            return 1;
+        }
+        if (!logPath.empty()) {
+            // Logged runs go through the Game-based simulator on one thread, in match order
+            Simulator simulator(seed);
+            simulator.setFormat(format->balls, format->players);
+            if (model == SKILL_MODEL) {
+                simulator.game.enableSkills();
+            }
+            if (counterRng) {
+                simulator.game.enableCounterRng(seed);
+            }
+            EventLogWriter log;
+            if (!log.open(logPath, simulator.logHeader())) {
+                std::cerr << "Cannot write event log '" << logPath << "'.\n";
+                return 1;
+            }
+            simulator.eventLog = &log;
+            SimulationResults results = simulator.run(numMatches);
+            if (!log.close()) {
+                std::cerr << "Error writing event log '" << logPath << "'.\n";
+                return 1;
+            }
+            results.print(std::cout);
+            printProfile(profile);
+            return 0;
+        }
+        LockstepRunFunction runLockstep = findLockstep(format->balls, format->players);
+        SimulationResults results = lockstep                   ? runLockstep(seed, threads, numMatches)
+                                    : counterRng               ? format->runCounter(seed, threads, numMatches)
+                                    : (model == UNIFORM_MODEL) ? format->run(seed, threads, numMatches)
+                                                               : format->runModel(seed, threads, numMatches, model);
+        results.print(std::cout);
+        printProfile(profile);
+        return 0;
+    }
+
+    // Exact odds: ./cricket_game --exact [format] prints the analytical score distribution and win probabilities
+    if (argc > 1 && std::string(argv[1]) == "--exact") {
+        std::string formatName = (argc > 2) ? argv[2] : "one-over";
+        if (!printExactOdds(formatName, std::cout)) {
+            std::cerr << "Unknown format '" << formatName << "'.\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    // Live mode: ./cricket_game --live N [--seed S] [--fps F] plays N matches at full speed on an in-place scorecard
+    if (argc > 1 && std::string(argv[1]) == "--live") {
+        long long numMatches = (argc > 2) ? atoll(argv[2]) : 1;
+        uint64_t seed = 0;
+        double fps = 30;
+        for (int i = 3; i + 1 < argc; i += 2) {
+            std::string option = argv[i];
+            if (option == "--seed") {
+                seed = strtoull(argv[i + 1], nullptr, 10);
+            } else if (option == "--fps") {
+                fps = atof(argv[i + 1]);
+            }
+        }
+        Simulator simulator(seed);
+        simulator.game.scorecard.inPlace = true;
+        simulator.game.scorecard.setFrameRate(fps);
+        simulator.game.winPredictor = findWinPredictor(simulator.game.maxDeliveries, simulator.game.playersPerTeam);
+        SimulationResults results = simulator.makeResults();
+        for (long long i = 0; i < numMatches; ++i) {
+            simulator.playMatchLive(i, results);
+        }
+        simulator.game.displayScoreCard(); // Final frame, whatever the frame rate
+        std::cerr << "Frames written: " << simulator.game.scorecard.framesWritten
+                  << ", skipped: " << simulator.game.scorecard.framesSkipped << "\n";
+        return 0;
+    }
+
+    // Watch mode: ./cricket_game --watch N [--seed S] [--speed X | --instant] paces N matches on one thread
+    if (argc > 1 && std::string(argv[1]) == "--watch") {
+        long long numMatches = (argc > 2) ? atoll(argv[2]) : 4;
+        uint64_t seed = 0;
+        for (int i = 3; i + 1 < argc; ++i) {
+            if (std::string(argv[i]) == "--seed") {
+                seed = strtoull(argv[i + 1], nullptr, 10);
+            }
+        }
+        Clock clock = clockFromArgs(argc, argv);
+        EventLoop loop(clock);
+        std::vector<std::unique_ptr<PacedMatch>> matches;
+        for (long long i = 0; i < numMatches; ++i) {
+            matches.emplace_back(new PacedMatch(loop, seed, i, std::cout));
+            matches.back()->start();
+        }
+        loop.run();
+        return 0;
+    }
+
+    // Fork mode: ./cricket_game --fork MATCH BALL N [--seed S] [--format F] [--skills] plays match MATCH
+    // of the headless run with seed S up to delivery BALL (counted across both innings), saves it and
+    // plays N continuations from there, printing each side's odds and the cost of a fork
+    if (argc > 1 && std::string(argv[1]) == "--fork") {
+        long long matchIndex = (argc > 2) ? atoll(argv[2]) : 0;
+        int ball = (argc > 3) ? atoi(argv[3]) : 0;
+        long long numForks = (argc > 4) ? atoll(argv[4]) : 10000;
+        uint64_t seed = 0;
+        std::string formatName = "one-over";
+        bool skills = false;
+        for (int i = 5; i < argc; ++i) {
+            std::string option = argv[i];
+            if (option == "--skills") {
+                skills = true;
+            } else if (i + 1 < argc && option == "--seed") {
+                seed = strtoull(argv[++i], nullptr, 10);
+            } else if (i + 1 < argc && option == "--format") {
+                formatName = argv[++i];
+            }
+        }
+        const FormatEntry* format = findFormat(formatName);
+        if (format == nullptr || format->players > MAX_LINEUP) {
+            std::cerr << "Unknown format '" << formatName << "' (or one too large to snapshot).\n";
+            return 1;
+        }
+        Simulator simulator(seed);
+        MatchForker forker(seed ^ 0xF0F0F0F0F0F0F0F0ULL);
+        if (skills) {
+            simulator.game.enableSkills();
+            forker.game.enableSkills();
+        }
+        simulator.setFormat(format->balls, format->players);
+        simulator.setUpMatch(matchIndex);
+        int played = simulator.game.playDeliveries(ball);
+
+        MatchState state;
+        simulator.game.saveState(state);
+        std::cout << "After " << played << " deliveries (innings " << static_cast<int>(state.inningsNum)
+                  << ", ball " << state.currentBall << "): TeamA " << simulator.game.teamA.totalRuns << "/"
+                  << simulator.game.teamA.totalWicketsLost << ", TeamB " << simulator.game.teamB.totalRuns << "/"
+                  << simulator.game.teamB.totalWicketsLost << "\n";
+        std::cout << "Snapshot: " << sizeof(MatchState) << " bytes\n";
+
+        ForkOdds odds;
+        auto start = std::chrono::steady_clock::now();
+        if (!forker.run(state, 0, numForks, odds)) {
+            std::cerr << "The snapshot does not fit the player pool.\n";
+            return 1;
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        odds.print(std::cout);
+        float teamAWins, teamBWins, draw;
+        simulator.game.winPredictor = findWinPredictor(format->balls, format->players);
+        if (simulator.game.winProbability(teamAWins, teamBWins, draw)) {
+            std::cout << "Exact: TeamA " << teamAWins << ", TeamB " << teamBWins << ", draw " << draw << "\n";
+        }
+        std::cerr << "Per fork (restore + play to the end): " << (odds.forks > 0 ? seconds * 1e6 / odds.forks : 0)
+                  << " us\n";
+        return 0;
+    }
+
+    // Server mode: ./cricket_game --serve [--channels N] [--port P] [--unix PATH] [--speed X] [--seed S]
+    // [--seconds T] [--max-pending BYTES] plays N matches at a time and streams ball-by-ball updates to
+    // every subscriber, dropping any that fall more than BYTES behind
+    if (argc > 1 && std::string(argv[1]) == "--serve") {
+        int channels = 64;
+        int port = -1;
+        std::string unixPath;
+        double speed = 1.0;
+        uint64_t seed = 0;
+        double seconds = 0;
+        long long maxPending = 0;
+        for (int i = 2; i + 1 < argc; i += 2) {
+            std::string option = argv[i];
+            if (option == "--channels") {
+                channels = atoi(argv[i + 1]);
+            } else if (option == "--port") {
+                port = atoi(argv[i + 1]);
+            } else if (option == "--unix") {
+                unixPath = argv[i + 1];
+            } else if (option == "--speed") {
+                speed = atof(argv[i + 1]);
+            } else if (option == "--seed") {
+                seed = strtoull(argv[i + 1], nullptr, 10);
+            } else if (option == "--seconds") {
+                seconds = atof(argv[i + 1]);
+            } else if (option == "--max-pending") {
+                maxPending = atoll(argv[i + 1]);
+            }
+        }
+        if (port < 0 && unixPath.empty()) {
+            port = 7070;
+        }
+        LiveServer server(channels, seed, speed);
+        if (maxPending > 0) {
+            server.maxPendingBytes = static_cast<size_t>(maxPending);
+        }
+        std::string error;
+        if ((port >= 0 && !server.listenTcp(port, error)) ||
+            (!unixPath.empty() && !server.listenUnix(unixPath, error)) || !server.run(seconds, error)) {
+            std::cerr << error << "\n";
+            return 1;
+        }
+        server.printStats(std::cerr);
+        return 0;
+    }
+
+    // Tournament mode: ./cricket_game --league TEAMS [--seasons N] [--knockout] [--legs L] [--seed S]
+    // [--threads T] [--format F] plays one season and prints the table, or with N > 1 seasons
+    // prints each team's title probability and the throughput
+    if (argc > 1 && std::string(argv[1]) == "--league") {
+        int numTeams = (argc > 2) ? atoi(argv[2]) : 8;
+        long long numSeasons = 1;
+        bool knockout = false;
+        int legs = 1;
+        uint64_t seed = 0;
+        int threads = 0;
+        std::string formatName = "one-over";
+        for (int i = 3; i < argc; ++i) {
+            std::string option = argv[i];
+            if (option == "--knockout") {
+                knockout = true;
+            } else if (i + 1 < argc && option == "--seasons") {
+                numSeasons = atoll(argv[++i]);
+            } else if (i + 1 < argc && option == "--legs") {
+                legs = atoi(argv[++i]);
+            } else if (i + 1 < argc && option == "--seed") {
+                seed = strtoull(argv[++i], nullptr, 10);
+            } else if (i + 1 < argc && option == "--threads") {
+                threads = atoi(argv[++i]);
+            } else if (i + 1 < argc && option == "--format") {
+                formatName = argv[++i];
+            }
+        }
+        const FormatEntry* format = findFormat(formatName);
+        if (format == nullptr || numTeams < 2 || legs < 1) {
+            std::cerr << "Need a known format, at least 2 teams and at least 1 leg.\n";
+            return 1;
+        }
+        Game game;
+        Tournament tournament(numTeams, format->balls, format->players, game.allPlayers, seed, legs);
+        WorkStealingPool workers(threads);
+
+        if (numSeasons <= 1 && knockout) {
+            int champion = tournament.playKnockout(game, 0);
+            std::cout << "Champion: " << tournament.teams[champion].name << "\n";
+            return 0;
+        }
+        if (numSeasons <= 1) {
+            GamePool games(workers.size());
+            std::vector<Game*> workerGames;
+            for (int w = 0; w < workers.size(); ++w) {
+                workerGames.push_back(games.acquire());
+            }
+            Standings standings(numTeams);
+            tournament.playLeagueSeason(workers, workerGames, 0, standings);
+            for (Game* workerGame : workerGames) {
+                games.release(workerGame);
+            }
+            std::cout << "Rounds: " << tournament.numRounds << ", fixtures: " << tournament.fixtures.size() << "\n";
+            standings.print(std::cout, tournament.teams);
+            return 0;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        TitleOdds odds = tournament.simulateSeasons(workers, numSeasons, knockout);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        odds.print(std::cout, tournament.teams, knockout);
+        std::cerr << "Throughput: " << odds.matches / seconds << " matches/s on " << workers.size() << " threads ("
+                  << odds.matches / seconds / workers.size() << " per thread), " << workers.steals() << " steals\n";
+        return 0;
+    }
+
+    // Batch mode: ./cricket_game --batch FILE plays every match spec in FILE ('-' for stdin),
+    // one per line, at full speed and prints one result line per match
+    if (argc > 1 && std::string(argv[1]) == "--batch") {
+        std::string path = (argc > 2) ? argv[2] : "-";
+        if (path == "-") {
+            return playSpecBatch(std::cin, std::cout, std::cerr) == 0 ? 0 : 1;
+        }
+        std::ifstream file(path);
+        if (!file) {
+            std::cerr << "Cannot read match specs '" << path << "'.\n";
+            return 1;
+        }
+        return playSpecBatch(file, std::cout, std::cerr) == 0 ? 0 : 1;
+    }
+
+    // Scripted mode: ./cricket_game --spec [key=value ...] [--speed X | --instant] plays one match
+    // as in interactive mode, with line-ups, toss call and choice taken from the spec instead of prompts
+    if (argc > 1 && std::string(argv[1]) == "--spec") {
+        std::string text;
+        for (int i = 2; i < argc; ++i) {
+            text += std::string(argv[i]) + " ";
+        }
+        Game game;
+        MatchSpec spec;
+        std::string error;
+        if (!spec.parse(text, error) || !spec.validate(static_cast<int>(game.allPlayers.size()), error)) {
+            std::cerr << "Invalid match spec: " << error << "\n";
+            return 1;
+        }
+        game.clock = clockFromArgs(argc, argv);
+        game.maxDeliveries = spec.format->balls;
+        game.playersPerTeam = spec.format->players;
+        game.winPredictor = findWinPredictor(game.maxDeliveries, game.playersPerTeam);
+        game.rng = Rng::forStream(spec.seed, spec.matchIndex >= 0 ? spec.matchIndex : 0);
+
+        game.welcome();
+        game.selectPlayers(spec.teamAPlayerIds, spec.teamBPlayerIds);
+        game.toss(spec.call, spec.choice);
+        game.startInnings(1);
+        game.startInnings(2);
+        game.displayMatchSummary();
+        return 0;
+    }
+
+    Game game; // Create a Game object
+    game.rng = Rng::fromEntropy(); // A different match every time
+    game.clock = clockFromArgs(argc, argv); // Interactive pacing: --speed X or --instant
+    game.winPredictor = findWinPredictor(game.maxDeliveries, game.playersPerTeam); // Live odds on the scorecard
+
+    game.welcome();           // Display welcome message and instructions
+    game.displayAllPlayers(); // Show the pool of available players
+    game.selectPlayers();     // Allow user to select players for teams
+    game.toss();              // Perform the toss and decide batting/bowling order
+
+    // First Innings
+    game.startInnings(1); // Start and play the first innings
+
+    // Second Innings
+    game.startInnings(2); // Start and play the second innings
+
+    game.displayMatchSummary(); // Display the final match summary
+
+    return 0;
+}
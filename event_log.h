@@ -0,0 +1,284 @@
+#ifndef CRICKET_EVENT_LOG_H
+#define CRICKET_EVENT_LOG_H
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fcntl.h>    // For open()
+#include <sys/mman.h> // For mmap()
+#include <sys/stat.h> // For fstat()
+#include <unistd.h>   // For write() and close()
+
+// Most players a team can list in a log header
+const int MAX_LOG_PLAYERS = 16;
+
+// --- DeliveryRecord Definition ---
+// One delivery in 8 bytes: match id, then a 16-bit field holding the ball
+// number within the innings (bits 0-8), innings - 1 (bit 9), runs (bits
+// 10-12), the wicket flag (bit 13) and whether TeamA batted first in the
+// match (bit 14), then the batsman and bowler ids. The toss is logged because
+// the line-ups may share players (11-a-side formats draw both from one pool
+// of 11), so the batsman's id alone does not tell the sides apart.
+// Records are written in native (little-endian) byte order.
+struct DeliveryRecord {
+    uint32_t matchId;
+    uint16_t info;
+    uint8_t batsmanId;
+    uint8_t bowlerId;
+
+    static DeliveryRecord make(uint32_t matchId, int innings, int ball, int batsmanId, int bowlerId,
+                               int runs, bool wicket, bool teamABatsFirst) {
+        DeliveryRecord record;
+        record.matchId = matchId;
+        record.info = static_cast<uint16_t>((ball & 0x1FF) | ((innings - 1) & 1) << 9 | (runs & 7) << 10 |
+                                            (wicket ? 1 : 0) << 13 | (teamABatsFirst ? 1 : 0) << 14);
+        record.batsmanId = static_cast<uint8_t>(batsmanId);
+        record.bowlerId = static_cast<uint8_t>(bowlerId);
+        return record;
+    }
+
+    int ball() const {
+        return info & 0x1FF;
+    }
+    int innings() const {
+        return ((info >> 9) & 1) + 1;
+    }
+    int runs() const {
+        return (info >> 10) & 7;
+    }
+    bool wicket() const {
+        return (info >> 13) & 1;
+    }
+    bool teamABatsFirst() const {
+        return (info >> 14) & 1;
+    }
+    // True if TeamA bats in this delivery's innings
+    bool teamABatting() const {
+        return teamABatsFirst() == (innings() == 1);
+    }
+};
+
+static_assert(sizeof(DeliveryRecord) == 8, "DeliveryRecord must stay 8 bytes");
+
+// --- EventLogHeader Definition ---
+// Start of every log file: the format and the two line-ups shared by all
+// matches in the file (player ids in batting order, 0 = unused slot).
+struct EventLogHeader {
+    char magic[8];
+    uint16_t version;
+    uint16_t recordSize;
+    uint16_t maxDeliveries;
+    uint16_t playersPerTeam;
+    uint8_t teamAPlayerIds[MAX_LOG_PLAYERS];
+    uint8_t teamBPlayerIds[MAX_LOG_PLAYERS];
+
+    static const uint16_t VERSION = 2; // 2: records carry the batting-first side
+
+    static EventLogHeader make(int maxDeliveries, const std::vector<int>& teamA, const std::vector<int>& teamB) {
+        EventLogHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, "CRICKLOG", 8);
+        header.version = VERSION;
+        header.recordSize = sizeof(DeliveryRecord);
+        header.maxDeliveries = static_cast<uint16_t>(maxDeliveries);
+        header.playersPerTeam = static_cast<uint16_t>(teamA.size());
+        for (size_t i = 0; i < teamA.size() && i < MAX_LOG_PLAYERS; ++i) {
+            header.teamAPlayerIds[i] = static_cast<uint8_t>(teamA[i]);
+        }
+        for (size_t i = 0; i < teamB.size() && i < MAX_LOG_PLAYERS; ++i) {
+            header.teamBPlayerIds[i] = static_cast<uint8_t>(teamB[i]);
+        }
+        return header;
+    }
+
+    bool isValid() const {
+        return std::memcmp(magic, "CRICKLOG", 8) == 0 && version == VERSION &&
+               recordSize == sizeof(DeliveryRecord) && playersPerTeam <= MAX_LOG_PLAYERS;
+    }
+};
+
+static_assert(sizeof(EventLogHeader) == 48, "EventLogHeader must stay 48 bytes");
+
+// --- EventLogWriter Class Definition ---
+// Append-only log writer. Records collect in a fixed buffer that is written
+// out with one write() whenever it fills up.
+class EventLogWriter {
+public:
+    long long recordsWritten;
+
+    // Constructor: 'bufferRecords' records are buffered between writes
+    explicit EventLogWriter(size_t bufferRecords = 1 << 16) :
+        recordsWritten(0),
+        fd(-1),
+        failed(false)
+    {
+        buffer.reserve(bufferRecords);
+    }
+
+    ~EventLogWriter() {
+        close();
+    }
+
+    // Creates (or truncates) 'path' and writes the header; returns false on failure
+    bool open(const std::string& path, const EventLogHeader& header) {
+        close();
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        failed = fd < 0;
+        if (!failed) {
+            writeAll(&header, sizeof(header));
+        }
+        return !failed;
+    }
+
+    // Appends one record
+    void append(const DeliveryRecord& record) {
+        buffer.push_back(record);
+        if (buffer.size() == buffer.capacity()) {
+            flush();
+        }
+        recordsWritten++;
+    }
+
+    // Writes out all buffered records
+    void flush() {
+        if (!buffer.empty() && fd >= 0) {
+            writeAll(buffer.data(), buffer.size() * sizeof(DeliveryRecord));
+        }
+        buffer.clear();
+    }
+
+    // Flushes and closes the file; returns false if any write failed
+    bool close() {
+        flush();
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+        return !failed;
+    }
+
+    bool isOpen() const {
+        return fd >= 0;
+    }
+
+private:
+    int fd;
+    bool failed;
+    std::vector<DeliveryRecord> buffer;
+
+    EventLogWriter(const EventLogWriter&) = delete;
+    EventLogWriter& operator=(const EventLogWriter&) = delete;
+
+    void writeAll(const void* data, size_t size) {
+        const char* bytes = static_cast<const char*>(data);
+        while (size > 0) {
+            ssize_t n = ::write(fd, bytes, size);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                failed = true;
+                return;
+            }
+            bytes += n;
+            size -= n;
+        }
+    }
+};
+
+// --- EventLogReader Class Definition ---
+// Memory-maps a log for zero-copy reads. Records are in match id order as
+// written by a Simulator, so any match can be found by binary search.
+class EventLogReader {
+public:
+    const EventLogHeader* header;
+    const DeliveryRecord* records;
+    size_t numRecords;
+
+    EventLogReader() :
+        header(nullptr),
+        records(nullptr),
+        numRecords(0),
+        mapping(nullptr),
+        mappedSize(0) {}
+
+    ~EventLogReader() {
+        close();
+    }
+
+    // Maps 'path'; returns false if it cannot be read or is not a log
+    bool open(const std::string& path) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(EventLogHeader)) {
+            ::close(fd);
+            return false;
+        }
+        mappedSize = info.st_size;
+        void* address = mmap(nullptr, mappedSize, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (address == MAP_FAILED) {
+            mappedSize = 0;
+            return false;
+        }
+        mapping = address;
+        header = static_cast<const EventLogHeader*>(mapping);
+        if (!header->isValid()) {
+            close();
+            return false;
+        }
+        records = reinterpret_cast<const DeliveryRecord*>(static_cast<const char*>(mapping) + sizeof(EventLogHeader));
+        numRecords = (mappedSize - sizeof(EventLogHeader)) / sizeof(DeliveryRecord);
+        return true;
+    }
+
+    void close() {
+        if (mapping != nullptr) {
+            munmap(mapping, mappedSize);
+        }
+        mapping = nullptr;
+        mappedSize = 0;
+        header = nullptr;
+        records = nullptr;
+        numRecords = 0;
+    }
+
+    // Index of the first record of 'matchId' (or of the next match after it)
+    size_t findMatch(uint32_t matchId) const {
+        size_t low = 0;
+        size_t high = numRecords;
+        while (low < high) {
+            size_t middle = low + (high - low) / 2;
+            if (records[middle].matchId < matchId) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        return low;
+    }
+
+    // One past the last record of the match starting at 'first'
+    size_t matchEnd(size_t first) const {
+        size_t end = first;
+        while (end < numRecords && records[end].matchId == records[first].matchId) {
+            end++;
+        }
+        return end;
+    }
+
+private:
+    void* mapping;
+    size_t mappedSize;
+
+    EventLogReader(const EventLogReader&) = delete;
+    EventLogReader& operator=(const EventLogReader&) = delete;
+};
+
+#endif // CRICKET_EVENT_LOG_H
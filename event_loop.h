@@ -0,0 +1,259 @@
+#ifndef CRICKET_EVENT_LOOP_H
+#define CRICKET_EVENT_LOOP_H
+
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <vector>
+#include "clock.h"
+#include "live_protocol.h"
+#include "simulator.h"
+
+// --- EventLoop Class Definition ---
+// Single-threaded timer loop over a virtual Clock. Tasks are run in order of
+// their virtual due time (ties in scheduling order), so one thread can pace
+// many matches at once instead of one blocked thread per match.
+class EventLoop {
+public:
+    Clock& clock;
+
+    // Constructor
+    explicit EventLoop(Clock& clock) :
+        clock(clock),
+        nextSequence(0) {}
+
+    // Runs 'task' once 'delayMicros' of virtual time have passed
+    void schedule(long long delayMicros, std::function<void()> task) {
+        Timer timer = {clock.nowMicros + delayMicros, nextSequence++, task};
+        timers.push(timer);
+    }
+
+    // Runs tasks until none are left
+    void run() {
+        while (!timers.empty()) {
+            Timer timer = timers.top();
+            timers.pop();
+            clock.sleepUntil(timer.dueMicros);
+            timer.task();
+        }
+    }
+
+    // Runs the tasks due by virtual time 'virtualMicros' (including any they schedule
+    // that are due by then) and moves the clock there, for loops driven from outside
+    // such as the live server's epoll loop
+    void runUntil(long long virtualMicros) {
+        while (!timers.empty() && timers.top().dueMicros <= virtualMicros) {
+            Timer timer = timers.top();
+            timers.pop();
+            clock.sleepUntil(timer.dueMicros);
+            timer.task();
+        }
+        clock.sleepUntil(virtualMicros);
+    }
+
+    bool empty() const {
+        return timers.empty();
+    }
+
+    // Virtual time of the earliest task (only meaningful if !empty())
+    long long nextDueMicros() const {
+        return timers.top().dueMicros;
+    }
+
+private:
+    struct Timer {
+        long long dueMicros;
+        long long sequence;
+        std::function<void()> task;
+
+        // Ordering for the queue: the earliest timer is on top
+        bool operator<(const Timer& other) const {
+            if (dueMicros != other.dueMicros) {
+                return dueMicros > other.dueMicros;
+            }
+            return sequence > other.sequence;
+        }
+    };
+
+    std::priority_queue<Timer> timers;
+    long long nextSequence;
+};
+
+// --- PacedMatch Class Definition ---
+// One headless match played ball by ball on an EventLoop, with one line of
+// commentary per event (or one LiveUpdate per event, for the live server)
+// and the same pauses as the interactive game between them.
+class PacedMatch {
+public:
+    static const long long TOSS_PAUSE = 5000000;          // Toss call, result and choice
+    static const long long INNINGS_START_PAUSE = 5000000; // Innings banner and line-up
+    static const long long BALL_PAUSE = 4500000;          // Run-up, shot and scorecard
+    static const long long WICKET_PAUSE = 3000000;        // OUT and next batsman
+    static const long long INNINGS_END_PAUSE = 2000000;   // Innings over banner
+
+    typedef std::function<void(const LiveUpdate&)> Publisher;
+
+    // Constructor: plays match 'matchIndex' of the simulator's seed, writing to 'out'
+    PacedMatch(EventLoop& loop, uint64_t masterSeed, long long matchIndex, std::ostream& out) :
+        loop(loop),
+        simulator(masterSeed),
+        matchIndex(matchIndex),
+        out(&out),
+        results(simulator.makeResults()),
+        firstBatting(nullptr),
+        finished(false) {}
+
+    // Constructor: plays match 'matchIndex' of the simulator's seed, passing every event to 'publish'
+    PacedMatch(EventLoop& loop, uint64_t masterSeed, long long matchIndex, Publisher publish) :
+        loop(loop),
+        simulator(masterSeed),
+        matchIndex(matchIndex),
+        out(nullptr),
+        publish(publish),
+        results(simulator.makeResults()),
+        firstBatting(nullptr),
+        finished(false) {}
+
+    // Schedules the match to begin on the loop
+    void start() {
+        loop.schedule(0, [this]() { toss(); });
+    }
+
+    bool isFinished() const {
+        return finished;
+    }
+
+    // Outcome of the match once it is finished
+    const SimulationResults& result() const {
+        return results;
+    }
+
+    long long index() const {
+        return matchIndex;
+    }
+
+    // The match as it stands (both teams empty before the toss)
+    const Game& game() const {
+        return simulator.game;
+    }
+
+    // One LIVE_SNAPSHOT update per team with the score so far, for a subscriber joining mid-match
+    void snapshot(const Publisher& to) const {
+        const Game& game = simulator.game;
+        if (game.battingTeam == nullptr) {
+            return;
+        }
+        for (const Team* team : {&game.teamA, &game.teamB}) {
+            LiveUpdate update = LiveUpdate::make(static_cast<uint32_t>(matchIndex), LIVE_SNAPSHOT, game.inningsNum,
+                                                 team == &game.teamB);
+            update.ball = static_cast<uint16_t>(team->totalBallsBowled);
+            update.wicket = (team == game.battingTeam);
+            update.totalRuns = static_cast<uint16_t>(team->totalRuns);
+            update.totalWickets = static_cast<uint8_t>(team->totalWicketsLost);
+            to(update);
+        }
+    }
+
+private:
+    EventLoop& loop;
+    Simulator simulator;
+    long long matchIndex;
+    std::ostream* out;   // Commentary, or nullptr
+    Publisher publish;   // Live updates, or empty
+    SimulationResults results;
+    Team* firstBatting;
+    bool finished;
+
+    std::ostream& commentary() {
+        return *out << "[Match " << matchIndex << "] ";
+    }
+
+    // Update of 'type' for the current innings, with the batting side's score
+    LiveUpdate update(LiveUpdateType type) const {
+        const Game& game = simulator.game;
+        LiveUpdate update = LiveUpdate::make(static_cast<uint32_t>(matchIndex), type, game.inningsNum,
+                                             game.battingTeam == &game.teamB);
+        update.ball = static_cast<uint16_t>(game.currentBall);
+        update.totalRuns = static_cast<uint16_t>(game.battingTeam->totalRuns);
+        update.totalWickets = static_cast<uint8_t>(game.battingTeam->totalWicketsLost);
+        return update;
+    }
+
+    void toss() {
+        simulator.setUpMatch(matchIndex);
+        Game& game = simulator.game;
+        if (out) {
+            commentary() << game.battingTeam->name << " will bat first and " << game.bowlingTeam->name
+                         << " will bowl first.\n";
+        }
+        if (publish) {
+            publish(update(LIVE_MATCH_START));
+        }
+        loop.schedule(TOSS_PAUSE, [this]() { startInnings(1); });
+    }
+
+    void startInnings(int inningsNumber) {
+        Game& game = simulator.game;
+        game.beginInnings(inningsNumber);
+        if (out) {
+            commentary() << "Innings " << inningsNumber << ": " << game.battingTeam->name << " batting, "
+                         << game.currentBowler->name << " bowling.\n";
+        }
+        if (publish) {
+            LiveUpdate start = update(LIVE_INNINGS_START);
+            start.batsmanId = static_cast<uint8_t>(game.currentBatsman ? game.currentBatsman->id : 0);
+            start.bowlerId = static_cast<uint8_t>(game.currentBowler->id);
+            publish(start);
+        }
+        loop.schedule(INNINGS_START_PAUSE, [this]() { ball(); });
+    }
+
+    void ball() {
+        Game& game = simulator.game;
+        Player* striker = game.currentBatsman;
+        int runs = game.bowlDelivery();
+        if (out) {
+            commentary() << "Ball " << game.currentBall << ": " << striker->name << " scores " << runs << " runs"
+                         << (runs == 0 ? " and is OUT" : "") << ". " << game.battingTeam->name << " "
+                         << game.battingTeam->totalRuns << "/" << game.battingTeam->totalWicketsLost << "\n";
+        }
+        if (publish) {
+            LiveUpdate delivery = update(LIVE_BALL);
+            delivery.batsmanId = static_cast<uint8_t>(striker->id);
+            delivery.bowlerId = static_cast<uint8_t>(game.currentBowler->id);
+            delivery.runs = static_cast<uint8_t>(runs);
+            delivery.wicket = striker->isOut;
+            publish(delivery);
+        }
+
+        long long pause = BALL_PAUSE + (runs == 0 ? WICKET_PAUSE : 0);
+        if (!game.isInningsOver(game.currentBall)) {
+            loop.schedule(pause, [this]() { ball(); });
+        } else if (game.inningsNum == 1) {
+            firstBatting = game.battingTeam;
+            simulator.recordFirstInnings(*firstBatting, results);
+            loop.schedule(pause + INNINGS_END_PAUSE, [this]() { startInnings(2); });
+        } else {
+            loop.schedule(pause + INNINGS_END_PAUSE, [this]() { finish(); });
+        }
+    }
+
+    void finish() {
+        Game& game = simulator.game;
+        simulator.recordMatch(*firstBatting, *game.battingTeam, results);
+        if (out) {
+            commentary() << "Result: " << game.teamA.name << " " << game.teamA.totalRuns << ", " << game.teamB.name
+                         << " " << game.teamB.totalRuns << " - "
+                         << (results.teamAWins ? "TEAM A WINS!" : results.teamBWins ? "TEAM B WINS!" : "MATCH DRAW!")
+                         << "\n";
+        }
+        if (publish) {
+            LiveUpdate end = update(LIVE_MATCH_END);
+            end.runs = static_cast<uint8_t>(results.teamAWins ? 1 : results.teamBWins ? 2 : 0);
+            publish(end);
+        }
+        finished = true;
+    }
+};
+
+#endif // CRICKET_EVENT_LOOP_H
@@ -0,0 +1,821 @@
+#ifndef CRICKET_GAME_H
+#define CRICKET_GAME_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <limits>   // Required for numeric_limits
+#include <algorithm> // Required for std::find
+#include <bitset>
+#include "clock.h"
+#include "counter_rng.h"
+#include "match_state.h"
+#include "profiler.h"
+#include "rng.h"
+#include "scorecard.h"
+#include "skill_model.h"
+#include "team.h"
+
+// Set of Player::ids (bit i = id i), for constant-time selection checks
+typedef std::bitset<64> PlayerSet;
+
+// Chance that the batting side wins, and of a tie, at one moment of a match
+struct WinChance {
+    float batting;
+    float draw;
+};
+
+// Live win-probability lookup (see win_probability.h): innings (1 or 2), balls bowled
+// in it, wickets lost, the batting side's runs and the first-innings total to beat
+typedef WinChance (*WinPredictorFunction)(int inningsNum, int ballsBowled, int wicketsLost, int runs,
+                                          int firstInningsRuns);
+
+// --- Game Class Definition ---
+class Game {
+public:
+    Team teamA;
+    Team teamB;
+    int playersPerTeam;
+    int maxDeliveries;
+    int inningsNum;
+
+    // Pointers for current game state
+    Team* battingTeam;
+    Team* bowlingTeam;
+    Player* currentBatsman;
+    Player* currentBowler;
+
+    // Progress of the current innings (kept here, not in locals, so an innings can be paused and resumed)
+    int currentBall;  // Balls bowled so far
+    int batsmanIndex; // Striker's place in the batting order
+
+    std::vector<Player> allPlayers; // Pool of all 11 players
+    PlayerSet selectedPlayers; // Ids of the players already picked for a team
+    Rng rng; // Source of every random decision in the match
+    mutable ScorecardRenderer scorecard; // Buffered scorecard output (one write per frame)
+    Clock clock; // All pacing pauses go through this (real time by default)
+    SkillModel skills; // Matchup alias tables, used when skillsEnabled
+    bool skillsEnabled; // Draw each ball from the batsman/bowler matchup instead of uniform 0-6
+    CounterRng counterRng; // Address-based toss and ball draws, used when counterRngEnabled
+    bool counterRngEnabled;
+    uint64_t matchIndex; // This match's address in counterRng
+    WinPredictorFunction winPredictor; // If set, the scorecard shows each side's chance of winning
+
+    // Constructor
+    Game() :
+        teamA("TeamA"),
+        teamB("TeamB"),
+        playersPerTeam(4),
+        maxDeliveries(6),
+        inningsNum(0),
+        battingTeam(nullptr),
+        bowlingTeam(nullptr),
+        currentBatsman(nullptr),
+        currentBowler(nullptr),
+        currentBall(0),
+        batsmanIndex(0),
+        rng(0), // Fixed until reseeded: simulations pick a stream, interactive play seeds from entropy
+        skillsEnabled(false),
+        counterRngEnabled(false),
+        matchIndex(0),
+        winPredictor(nullptr)
+    {
+        // Initialize the pool of 11 players
+        allPlayers.reserve(11);
+        allPlayers.push_back(Player("Virat", 1));
+        allPlayers.push_back(Player("Rohit", 2));
+        allPlayers.push_back(Player("Dhawan", 3));
+        allPlayers.push_back(Player("Rahul", 4));
+        allPlayers.push_back(Player("Hardik", 5));
+        allPlayers.push_back(Player("Jadeja", 6));
+        allPlayers.push_back(Player("Bumrah", 7));
+        allPlayers.push_back(Player("Shami", 8));
+        allPlayers.push_back(Player("Yuzvendra", 9));
+        allPlayers.push_back(Player("Kuldeep", 10));
+        allPlayers.push_back(Player("Rishabh", 11));
+
+        // Size the teams for the whole pool up front, so picking line-ups never reallocates
+        teamA.players.reserve(allPlayers.size());
+        teamB.players.reserve(allPlayers.size());
+    }
+
+    // Clears both teams and all match state so the Game can be played again
+    void resetMatch() {
+        resetStats();
+        teamA.players.clear();
+        teamB.players.clear();
+        selectedPlayers.reset();
+    }
+
+    // Zeroes every Player and Team counter in place, keeping the line-ups, so the
+    // same teams can play again without touching the heap
+    void resetStats() {
+        teamA.resetStats();
+        teamB.resetStats();
+        scorecard.markAllDirty();
+        inningsNum = 0;
+        battingTeam = nullptr;
+        bowlingTeam = nullptr;
+        currentBatsman = nullptr;
+        currentBowler = nullptr;
+        currentBall = 0;
+        batsmanIndex = 0;
+    }
+
+    // Copies of a Game point at their own teams and players, not the original's
+    Game(const Game& other) :
+        Game()
+    {
+        *this = other;
+    }
+
+    Game& operator=(const Game& other) {
+        if (this == &other) {
+            return *this;
+        }
+        teamA = other.teamA;
+        teamB = other.teamB;
+        playersPerTeam = other.playersPerTeam;
+        maxDeliveries = other.maxDeliveries;
+        inningsNum = other.inningsNum;
+        currentBall = other.currentBall;
+        batsmanIndex = other.batsmanIndex;
+        allPlayers = other.allPlayers;
+        selectedPlayers = other.selectedPlayers;
+        rng = other.rng;
+        scorecard = other.scorecard;
+        clock = other.clock;
+        skills = other.skills;
+        counterRng = other.counterRng;
+        counterRngEnabled = other.counterRngEnabled;
+        matchIndex = other.matchIndex;
+        skillsEnabled = other.skillsEnabled;
+        winPredictor = other.winPredictor;
+
+        battingTeam = teamAt(other.teamIndex(other.battingTeam));
+        bowlingTeam = teamAt(other.teamIndex(other.bowlingTeam));
+        currentBatsman = playerAt(battingTeam, other.playerIndex(other.battingTeam, other.currentBatsman));
+        currentBowler = playerAt(bowlingTeam, other.playerIndex(other.bowlingTeam, other.currentBowler));
+        return *this;
+    }
+
+    // --- Pointer-free match state ---
+
+    // 0 for TeamA, 1 for TeamB, NO_INDEX for neither
+    int teamIndex(const Team* team) const {
+        return team == &teamA ? 0 : team == &teamB ? 1 : NO_INDEX;
+    }
+
+    Team* teamAt(int index) {
+        return index == 0 ? &teamA : index == 1 ? &teamB : nullptr;
+    }
+
+    // Place of 'player' in 'team', NO_INDEX if either is missing
+    static int playerIndex(const Team* team, const Player* player) {
+        return (team != nullptr && player != nullptr) ? static_cast<int>(player - team->players.data()) : NO_INDEX;
+    }
+
+    static Player* playerAt(Team* team, int index) {
+        return (team != nullptr && index >= 0 && index < static_cast<int>(team->players.size()))
+                   ? &team->players[index] : nullptr;
+    }
+
+    // Saves the match as it stands (between balls) into 'state'; false if a side
+    // is larger than MAX_LINEUP
+    bool saveState(MatchState& state) const {
+        if (teamA.players.size() > MAX_LINEUP || teamB.players.size() > MAX_LINEUP) {
+            return false;
+        }
+        state.begin();
+        state.inningsNum = static_cast<uint8_t>(inningsNum);
+        state.battingTeam = static_cast<uint8_t>(teamIndex(battingTeam));
+        state.batsmanIndex = static_cast<uint8_t>(batsmanIndex);
+        state.bowlerIndex = static_cast<uint8_t>(playerIndex(bowlingTeam, currentBowler));
+        state.playersPerTeam = static_cast<uint8_t>(playersPerTeam);
+        state.maxDeliveries = static_cast<uint16_t>(maxDeliveries);
+        state.currentBall = static_cast<uint16_t>(currentBall);
+        state.rngState = rng.state;
+        const Team* teams[2] = {&teamA, &teamB};
+        for (int t = 0; t < 2; ++t) {
+            MatchState::TeamState& saved = state.teams[t];
+            saved.totalRuns = static_cast<uint16_t>(teams[t]->totalRuns);
+            saved.totalBallsBowled = static_cast<uint16_t>(teams[t]->totalBallsBowled);
+            saved.extras = static_cast<uint16_t>(teams[t]->extras);
+            saved.totalWicketsLost = static_cast<uint8_t>(teams[t]->totalWicketsLost);
+            saved.numPlayers = static_cast<uint8_t>(teams[t]->players.size());
+            for (size_t i = 0; i < teams[t]->players.size(); ++i) {
+                MatchState::savePlayer(teams[t]->players[i], saved.players[i]);
+            }
+        }
+        return true;
+    }
+
+    // Carries on from 'state' (saved by any Game with the same player pool) with no
+    // I/O; returns false, leaving the Game reset, if the state does not fit the pool.
+    // If the line-ups are the ones already fielded, only the counters are overwritten.
+    bool restoreState(const MatchState& state) {
+        if (!state.isValid() || state.teams[0].numPlayers > MAX_LINEUP || state.teams[1].numPlayers > MAX_LINEUP ||
+            (state.battingTeam > 1 && state.battingTeam != NO_INDEX) || state.inningsNum > 2) {
+            resetMatch();
+            return false;
+        }
+        Team* teams[2] = {&teamA, &teamB};
+        bool sameLineups = true;
+        for (int t = 0; t < 2 && sameLineups; ++t) {
+            const MatchState::TeamState& saved = state.teams[t];
+            sameLineups = teams[t]->players.size() == saved.numPlayers;
+            for (int i = 0; i < saved.numPlayers && sameLineups; ++i) {
+                sameLineups = teams[t]->players[i].id == saved.players[i].id;
+            }
+        }
+        if (sameLineups) {
+            resetStats();
+        } else {
+            resetMatch();
+        }
+        for (int t = 0; t < 2; ++t) {
+            const MatchState::TeamState& saved = state.teams[t];
+            for (int i = 0; i < saved.numPlayers; ++i) {
+                if (!sameLineups) {
+                    int id = saved.players[i].id;
+                    if (id < 1 || id > static_cast<int>(allPlayers.size())) {
+                        resetMatch();
+                        return false;
+                    }
+                    addToTeam(*teams[t], id);
+                }
+                MatchState::restorePlayer(saved.players[i], teams[t]->players[i]);
+            }
+            teams[t]->totalRuns = saved.totalRuns;
+            teams[t]->totalBallsBowled = saved.totalBallsBowled;
+            teams[t]->extras = saved.extras;
+            teams[t]->totalWicketsLost = saved.totalWicketsLost;
+        }
+        inningsNum = state.inningsNum;
+        playersPerTeam = state.playersPerTeam;
+        maxDeliveries = state.maxDeliveries;
+        currentBall = state.currentBall;
+        batsmanIndex = state.batsmanIndex;
+        rng.state = state.rngState;
+        battingTeam = teamAt(state.battingTeam);
+        bowlingTeam = teamAt(state.battingTeam == 0 ? 1 : state.battingTeam == 1 ? 0 : NO_INDEX);
+        currentBatsman = playerAt(battingTeam, batsmanIndex);
+        currentBowler = playerAt(bowlingTeam, state.bowlerIndex);
+        return true;
+    }
+
+    // Draws the toss and every uniform ball of match 'matchIndex' from the counter-based
+    // generator of 'seed' from now on: ball b of innings i is the same draw however the
+    // match got there (skill-model balls still use rng)
+    void enableCounterRng(uint64_t seed) {
+        counterRng = CounterRng(seed);
+        counterRngEnabled = true;
+    }
+
+    // Gives the pool its default skill profiles and draws every ball from the
+    // batsman/bowler matchup from now on; the teams are cleared so the next
+    // line-ups are picked with their profiles
+    void enableSkills() {
+        applyDefaultProfiles(allPlayers);
+        skills.resize(static_cast<int>(allPlayers.size()));
+        skillsEnabled = true;
+        resetMatch();
+    }
+
+    // Displays welcome message and instructions
+    void welcome() {
+        std::cout << "\n\n\t\t----------------------------------------\n";
+        std::cout << "\t\t|        WELCOME TO CRICKET GAME!      |\n";
+        std::cout << "\t\t----------------------------------------\n\n";
+
+        std::cout << "Instructions:\n";
+        std::cout << "1. Two teams (TeamA and TeamB) will play.\n";
+        std::cout << "2. Each team will have " << playersPerTeam << " players selected by you.\n";
+        std::cout << "3. Each innings will be of " << maxDeliveries << " balls.\n";
+        std::cout << "4. If a batsman scores 0 runs in a delivery, they are OUT.\n";
+        std::cout << "5. The team with more runs wins. If scores are tied, it's a DRAW.\n\n";
+
+        clock.pause(3000000); // 3 seconds pause
+    }
+
+    // Displays the pool of 11 players
+    void displayAllPlayers() {
+        std::cout << "\t----------------------------------\n";
+        std::cout << "\t|         Pool of Players        |\n";
+        std::cout << "\t----------------------------------\n";
+        for (const auto& player : allPlayers) {
+            std::cout << "\t" << player.id << ". " << player.name << "\n";
+        }
+        std::cout << "\t----------------------------------\n\n";
+        clock.pause(2000000); // 2 seconds pause
+    }
+
+    // Utility to take safe integer input
+    int takeIntegerInput() {
+        int choice;
+        while (!(std::cin >> choice)) {
+            std::cout << "\tInvalid input. Please enter a number: ";
+            std::cin.clear(); // Clear error flags
+            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // Discard invalid input
+        }
+        return choice;
+    }
+
+    // Validates if player is already selected or if ID is valid
+    bool checkPlayerSelection(int playerId) {
+        // Check if player ID is valid (1-11)
+        if (playerId < 1 || playerId > static_cast<int>(allPlayers.size())) {
+            return false;
+        }
+
+        // Check if player is already selected
+        return !selectedPlayers.test(playerId);
+    }
+
+    // Adds a player from the pool to a team and marks them as selected
+    void addToTeam(Team& team, int playerId) {
+        team.addPlayer(allPlayers[playerId - 1]);
+        selectedPlayers.set(playerId);
+    }
+
+    // True if 'team' holds exactly the players 'playerIds', in order
+    static bool hasLineup(const Team& team, const std::vector<int>& playerIds) {
+        if (team.players.size() != playerIds.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < playerIds.size(); ++i) {
+            if (team.players[i].id != playerIds[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Sets up both line-ups for a new match with no I/O. If they are the same as
+    // last match's, the counters are just zeroed in place.
+    void fieldTeams(const std::vector<int>& teamAPlayerIds, const std::vector<int>& teamBPlayerIds) {
+        CRICKET_PROFILE_PHASE(PHASE_SELECTION);
+        if (hasLineup(teamA, teamAPlayerIds) && hasLineup(teamB, teamBPlayerIds)) {
+            resetStats();
+            return;
+        }
+        resetMatch();
+        for (int id : teamAPlayerIds) {
+            addToTeam(teamA, id);
+        }
+        for (int id : teamBPlayerIds) {
+            addToTeam(teamB, id);
+        }
+    }
+
+    // Allows user to select players for both teams
+    void selectPlayers() {
+        CRICKET_PROFILE_PHASE(PHASE_SELECTION);
+        std::cout << "\t----------------------------------\n";
+        std::cout << "\t|         Team Selection         |\n";
+        std::cout << "\t----------------------------------\n";
+
+        // Select players for TeamA
+        std::cout << "\tSelect " << playersPerTeam << " players for TeamA:\n";
+        for (int i = 0; i < playersPerTeam; ++i) {
+            int playerId;
+            while (true) {
+                std::cout << "\tPlayer " << (i + 1) << " (TeamA) - Enter player ID: ";
+                playerId = takeIntegerInput();
+                if (checkPlayerSelection(playerId)) {
+                    addToTeam(teamA, playerId); // Add selected player to TeamA
+                    std::cout << "\t" << allPlayers[playerId - 1].name << " added to TeamA.\n";
+                    break;
+                } else {
+                    std::cout << "\tInvalid selection! Player ID must be between 1-" << allPlayers.size() << " and not already selected. Try again.\n";
+                }
+            }
+        }
+        std::cout << "\n";
+        clock.pause(1000000); // 1 second pause
+
+        // Select players for TeamB
+        std::cout << "\tSelect " << playersPerTeam << " players for TeamB:\n";
+        for (int i = 0; i < playersPerTeam; ++i) {
+            int playerId;
+            while (true) {
+                std::cout << "\tPlayer " << (i + 1) << " (TeamB) - Enter player ID: ";
+                playerId = takeIntegerInput();
+                if (checkPlayerSelection(playerId)) {
+                    addToTeam(teamB, playerId); // Add selected player to TeamB
+                    std::cout << "\t" << allPlayers[playerId - 1].name << " added to TeamB.\n";
+                    break;
+                } else {
+                    std::cout << "\tInvalid selection! Player ID must be between 1-" << allPlayers.size() << " and not already selected. Try again.\n";
+                }
+            }
+        }
+        std::cout << "\n";
+        clock.pause(1000000); // 1 second pause
+
+        // Display selected teams
+        teamA.displayTeamPlayers();
+        teamB.displayTeamPlayers();
+        clock.pause(2000000); // 2 seconds pause
+    }
+
+    // Picks both line-ups from already validated player ids (e.g. a MatchSpec) instead of prompting
+    void selectPlayers(const std::vector<int>& teamAPlayerIds, const std::vector<int>& teamBPlayerIds) {
+        CRICKET_PROFILE_PHASE(PHASE_SELECTION);
+        std::cout << "\t----------------------------------\n";
+        std::cout << "\t|         Team Selection         |\n";
+        std::cout << "\t----------------------------------\n";
+        for (int id : teamAPlayerIds) {
+            addToTeam(teamA, id);
+        }
+        for (int id : teamBPlayerIds) {
+            addToTeam(teamB, id);
+        }
+        teamA.displayTeamPlayers();
+        teamB.displayTeamPlayers();
+        clock.pause(2000000); // 2 seconds pause
+    }
+
+    // Determines which team won the toss based on call and result
+    bool tossWinnerIsTeamA(int call, int tossResult) const {
+        if ((tossResult == 0 && call == 1) || (tossResult == 1 && call == 2)) {
+            return call == 1;
+        }
+        // Random winner or incorrect call: Heads goes to TeamA, Tails to TeamB
+        return tossResult == 0;
+    }
+
+    // Sets the batting order from the toss winner's choice (1 = Bat, anything else = Bowl)
+    void applyTossChoice(bool teamAWonToss, int choice) {
+        if (teamAWonToss == (choice == 1)) { // TeamA bats
+            battingTeam = &teamA;
+            bowlingTeam = &teamB;
+        } else { // TeamB bats
+            battingTeam = &teamB;
+            bowlingTeam = &teamA;
+        }
+    }
+
+    // Tosses the coin with no I/O for a known call (1 or 2, anything else is random) and
+    // choice (1 = Bat, 2 = Bowl, anything else is random); returns the coin (0 = Heads).
+    // Both draws are always made, so the balls that follow do not depend on the choice.
+    int decideToss(int call, int choice) {
+        CRICKET_PROFILE_PHASE(PHASE_TOSS);
+        int tossResult, randomChoice;
+        if (counterRngEnabled) {
+            CounterRng::Cursor draws = counterRng.at(matchIndex, 0, 0); // Innings 0 is the toss
+            tossResult = draws.below(2);
+            randomChoice = 1 + draws.below(2);
+        } else {
+            tossResult = rng.below(2);
+            randomChoice = 1 + rng.below(2);
+        }
+        applyTossChoice(tossWinnerIsTeamA(call, tossResult), (choice == 1 || choice == 2) ? choice : randomChoice);
+        return tossResult;
+    }
+
+    // Handles the toss with the call and choice given up front instead of prompts
+    void toss(int call, int choice) {
+        std::cout << "\t----------------------------------\n";
+        std::cout << "\t|          TOSS TIME!            |\n";
+        std::cout << "\t----------------------------------\n";
+
+        int tossResult = decideToss(call, choice);
+        bool teamAWonToss = tossWinnerIsTeamA(call, tossResult);
+        std::string winningTeamName = teamAWonToss ? teamA.name : teamB.name;
+        bool winnerBats = (battingTeam == &teamA) == teamAWonToss;
+
+        std::cout << "\tIt's " << (tossResult == 0 ? "Heads" : "Tails") << "! Team " << winningTeamName << " wins the toss!\n";
+        clock.pause(2000000); // 2 seconds pause
+
+        std::cout << "\t" << winningTeamName << " chooses to " << (winnerBats ? "bat" : "bowl") << ".\n";
+        std::cout << "\t" << battingTeam->name << " will bat first and " << bowlingTeam->name << " will bowl first.\n\n";
+        clock.pause(3000000); // 3 seconds pause
+    }
+
+    // Handles the toss functionality
+    void toss() {
+        std::cout << "\t----------------------------------\n";
+        std::cout << "\t|          TOSS TIME!            |\n";
+        std::cout << "\t----------------------------------\n";
+
+        std::cout << "\tPress 1 for TeamA or 2 for TeamB to call (Heads/Tails):\n";
+        std::cout << "\t(Any number other than 1 or 2 will be considered random choice)\n";
+        int call = takeIntegerInput();
+        std::cout << "\n";
+
+        // Simulate toss: 0 for heads, 1 for tails
+        int tossResult = rng.below(2); // 0 or 1
+
+        bool teamAWonToss = tossWinnerIsTeamA(call, tossResult);
+        std::string winningTeamName = teamAWonToss ? teamA.name : teamB.name;
+
+        std::cout << "\tIt's " << (tossResult == 0 ? "Heads" : "Tails") << "! Team " << winningTeamName << " wins the toss!\n";
+        clock.pause(2000000); // 2 seconds pause
+
+        std::cout << "\t" << winningTeamName << ", what do you choose?\n";
+        std::cout << "\t1. Bat\n";
+        std::cout << "\t2. Bowl\n";
+        int choice = takeIntegerInput();
+        applyTossChoice(teamAWonToss, choice);
+
+        std::cout << "\t" << battingTeam->name << " will bat first and " << bowlingTeam->name << " will bowl first.\n\n";
+        clock.pause(3000000); // 3 seconds pause
+    }
+
+    // Returns the index of the first not-out batsman at or after 'from'
+    int nextAvailableBatsman(int from) const {
+        while (from < battingTeam->players.size() && battingTeam->players[from].isOut) {
+            from++;
+        }
+        return from;
+    }
+
+    // Sets up the game state for an innings (no I/O)
+    void beginInnings(int inningsNumber) {
+        inningsNum = inningsNumber;
+
+        // Swap batting and bowling teams for the second innings
+        if (inningsNum == 2) {
+            Team* temp = battingTeam;
+            battingTeam = bowlingTeam;
+            bowlingTeam = temp;
+
+            // Reset player states for the new innings (especially isOut)
+            for (auto& player : teamA.players) {
+                player.isOut = false;
+            }
+            for (auto& player : teamB.players) {
+                player.isOut = false;
+            }
+        }
+
+        // Initialize batsman and bowler for the innings
+        currentBall = 0;
+        batsmanIndex = nextAvailableBatsman(0);
+        currentBatsman = (batsmanIndex < battingTeam->players.size()) ? &battingTeam->players[batsmanIndex] : nullptr;
+
+        currentBowler = &bowlingTeam->players[0]; // First player to bowl
+    }
+
+    // Starts an innings
+    void startInnings(int inningsNumber) {
+        std::cout << "\t----------------------------------\n";
+        std::cout << "\t|         INNINGS " << inningsNumber << " BEGINS         |\n";
+        std::cout << "\t----------------------------------\n\n";
+        clock.pause(2000000); // 2 seconds pause
+
+        beginInnings(inningsNumber);
+
+        std::cout << "\t" << battingTeam->name << " is batting.\n";
+        std::cout << "\t" << bowlingTeam->name << " is bowling.\n";
+
+        if (currentBatsman) {
+            std::cout << "\t" << currentBatsman->name << " is on strike.\n";
+        } else {
+            std::cout << "\tAll batsmen are out for " << battingTeam->name << "!\n";
+        }
+        std::cout << "\t" << currentBowler->name << " is bowling.\n\n";
+
+        clock.pause(3000000); // 3 seconds pause
+        playInnings(); // Start playing the current innings
+    }
+
+    // Returns true once the innings is over on balls, wickets or (in innings 2) a chased target
+    bool isInningsOver(int ballsBowled) const {
+        if (ballsBowled >= maxDeliveries ||                      // Overs finished
+            battingTeam->totalWicketsLost >= playersPerTeam) {   // All out
+            return true;
+        }
+        return inningsNum == 2 && battingTeam->totalRuns > bowlingTeam->totalRuns; // Target chased
+    }
+
+    // Applies one delivery's outcome with no I/O: updates player and team stats,
+    // brings in the next batsman on a wicket and moves on to the next ball
+    void recordDelivery(int runsScored, bool wicket) {
+        // Update player and team stats
+        currentBatsman->runsScored += runsScored;
+        currentBatsman->ballsPlayed++;
+        battingTeam->totalRuns += runsScored;
+
+        currentBowler->ballsBowled++;
+        currentBowler->runsGiven += runsScored;
+
+        // Update balls bowled for the batting team's innings, and for the bowling team's overall stats
+        battingTeam->totalBallsBowled++;
+        // Note: Bowling team's totalBallsBowled increments each ball across both innings
+        // If you want per-innings, you'd need to reset it, but problem implies cumulative for bowler.
+
+        if (wicket) {
+            currentBatsman->isOut = true;
+            currentBatsman->dismissal = BOWLED;
+            battingTeam->totalWicketsLost++;
+            currentBowler->wicketsTaken++;
+
+            // Move to next batsman if available and not out
+            batsmanIndex = nextAvailableBatsman(batsmanIndex + 1);
+            currentBatsman = (batsmanIndex < battingTeam->players.size()) ? &battingTeam->players[batsmanIndex] : nullptr;
+        }
+        currentBall++;
+    }
+
+    // Bowls one delivery with no I/O: draws the runs and records them.
+    // Returns the runs scored.
+    int bowlDelivery() {
+        // Simulate runs (0-6): uniform (from the sequential or the counter-based generator),
+        // or from the matchup's alias table
+        int runsScored = skillsEnabled ? skills.sample(*currentBatsman, *currentBowler, rng)
+                         : counterRngEnabled ? counterRng.below(7, matchIndex, inningsNum, currentBall)
+                                             : rng.below(7);
+
+        // Check for OUT criteria (0 runs)
+        recordDelivery(runsScored, runsScored == 0);
+        return runsScored;
+    }
+
+    // Plays one innings without pauses or console output (used by the headless simulator).
+    // After each ball, onBall(ballIndex, striker, bowler, runs) is called; the striker's
+    // isOut tells whether it was a wicket.
+    template <typename OnBall>
+    void simulateInnings(int inningsNumber, OnBall onBall) {
+        beginInnings(inningsNumber);
+        continueInnings(onBall);
+    }
+
+    // Plays the rest of the current innings from currentBall, like simulateInnings(),
+    // stopping early after 'ballLimit' deliveries; returns the deliveries played
+    template <typename OnBall>
+    int continueInnings(OnBall onBall, int ballLimit = std::numeric_limits<int>::max()) {
+        CRICKET_PROFILE_PHASE(PHASE_INNINGS);
+        int played = 0;
+        if (currentBatsman == nullptr) {
+            return played;
+        }
+        while (played < ballLimit && !isInningsOver(currentBall)) {
+            Player* striker = currentBatsman;
+            int ball = currentBall;
+            int runs = bowlDelivery();
+            onBall(ball, *striker, *currentBowler, runs);
+            played++;
+        }
+        return played;
+    }
+
+    // Plays one innings without pauses or console output
+    void simulateInnings(int inningsNumber) {
+        simulateInnings(inningsNumber, [](int, const Player&, const Player&, int) {});
+    }
+
+    // True once no more balls can be bowled in the current innings
+    bool isInningsFinished() const {
+        return inningsNum == 0 ? false : currentBatsman == nullptr || isInningsOver(currentBall);
+    }
+
+    // True once the second innings is finished
+    bool isMatchOver() const {
+        return inningsNum == 2 && isInningsFinished();
+    }
+
+    // Plays up to 'count' more deliveries of the match (the toss already done) with no
+    // I/O, starting each innings as it comes; returns the deliveries played
+    int playDeliveries(int count) {
+        int played = 0;
+        while (played < count && !isMatchOver()) {
+            if (inningsNum == 0 || isInningsFinished()) {
+                beginInnings(inningsNum + 1);
+            }
+            played += continueInnings([](int, const Player&, const Player&, int) {}, count - played);
+        }
+        return played;
+    }
+
+    // Plays the rest of the match, from wherever it stands after the toss, with no I/O
+    void playToEnd() {
+        playDeliveries(std::numeric_limits<int>::max());
+    }
+
+    // Plays one innings at full speed, drawing each ball on the scorecard renderer
+    // (which drops frames to honour its frame rate; call displayScoreCard() for a final frame)
+    void simulateInningsLive(int inningsNumber) {
+        simulateInnings(inningsNumber, [this](int, const Player& striker, const Player& bowler, int) {
+            scorecard.markPlayerDirty(*battingTeam, &striker);
+            scorecard.markPlayerDirty(*bowlingTeam, &bowler);
+            updateWinProbability();
+            scorecard.render(teamA, teamB, maxDeliveries, inningsNum, battingTeam, bowlingTeam);
+        });
+    }
+
+    // Plays one innings
+    void playInnings() {
+        CRICKET_PROFILE_PHASE(PHASE_INNINGS);
+        currentBall = 0;
+
+        // Find the starting batsman
+        batsmanIndex = nextAvailableBatsman(0);
+        if (batsmanIndex < battingTeam->players.size()) {
+            currentBatsman = &battingTeam->players[batsmanIndex];
+        } else {
+            // All batsmen already out (shouldn't happen at start of innings 1, but for innings 2 it's possible)
+            std::cout << "\tNo batsmen left to bat for " << battingTeam->name << ".\n";
+            return;
+        }
+
+        // The first bowler always bowls all 6 deliveries
+        currentBowler = &bowlingTeam->players[0];
+
+        while (!isInningsOver(currentBall)) {
+            std::cout << "\t" << currentBatsman->name << " on strike. " << currentBowler->name << " bowling.\n";
+            std::cout << "\tBall " << (currentBall + 1) << " of " << maxDeliveries << "...\n";
+            clock.pause(1500000); // 1.5 seconds pause
+
+            Player* striker = currentBatsman;
+            int runsScored = bowlDelivery();
+            scorecard.markPlayerDirty(*battingTeam, striker);
+            scorecard.markPlayerDirty(*bowlingTeam, currentBowler);
+
+            std::cout << "\t" << striker->name << " scores " << runsScored << " runs!\n";
+            clock.pause(1000000); // 1 second pause
+
+            if (runsScored == 0) {
+                std::cout << "\t" << striker->name << " is OUT!\n";
+                clock.pause(1500000); // 1.5 seconds pause
+
+                if (currentBatsman) {
+                    std::cout << "\tNext batsman: " << currentBatsman->name << "\n";
+                    clock.pause(1500000); // 1.5 seconds pause
+                } else {
+                    std::cout << "\tAll batsmen are out for " << battingTeam->name << "!\n";
+                    clock.pause(1500000);
+                }
+            }
+            displayScoreCard();
+            clock.pause(2000000); // 2 seconds pause
+        }
+        std::cout << "\t----------------------------------\n";
+        std::cout << "\t|         INNINGS " << inningsNum << " OVER!         |\n";
+        std::cout << "\t----------------------------------\n\n";
+        clock.pause(2000000); // 2 seconds pause
+    }
+
+    // Live chance of TeamA winning, TeamB winning and a tie as the match stands; false
+    // before the toss, with no predictor, or with skills (the tables assume uniform balls)
+    bool winProbability(float& teamAWins, float& teamBWins, float& draw) const {
+        if (winPredictor == nullptr || skillsEnabled || battingTeam == nullptr) {
+            return false;
+        }
+        WinChance chance = winPredictor(inningsNum == 2 ? 2 : 1, battingTeam->totalBallsBowled, battingTeam->totalWicketsLost,
+                                        battingTeam->totalRuns, bowlingTeam->totalRuns);
+        float battingLoses = 1.0f - chance.batting - chance.draw;
+        teamAWins = battingTeam == &teamA ? chance.batting : battingLoses;
+        teamBWins = battingTeam == &teamB ? chance.batting : battingLoses;
+        draw = chance.draw;
+        return true;
+    }
+
+    // Passes the live win probability (if any) to the scorecard
+    void updateWinProbability() const {
+        float teamAWins, teamBWins, draw;
+        if (winProbability(teamAWins, teamBWins, draw)) {
+            scorecard.setWinProbability(teamAWins, teamBWins, draw);
+        } else {
+            scorecard.clearWinProbability();
+        }
+    }
+
+    // Displays the current game scorecard
+    void displayScoreCard() const {
+        std::cout.flush(); // Keep the frame after everything already printed
+        updateWinProbability();
+        scorecard.render(teamA, teamB, maxDeliveries, inningsNum, battingTeam, bowlingTeam, true);
+    }
+
+    // Displays the match summary at the end
+    void displayMatchSummary() const {
+        std::cout << "\n\n\t----------------------------------------\n";
+        std::cout << "\t|           MATCH SUMMARY              |\n";
+        std::cout << "\t----------------------------------------\n";
+        displayScoreCard(); // Show final scorecard
+
+        std::cout << "\tFinal Scores:\n";
+        std::cout << "\t" << teamA.name << ": " << teamA.totalRuns << "/" << teamA.totalWicketsLost << " (" << teamA.totalBallsBowled << " balls)\n";
+        std::cout << "\t" << teamB.name << ": " << teamB.totalRuns << "/" << teamB.totalWicketsLost << " (" << teamB.totalBallsBowled << " balls)\n\n";
+
+        if (teamA.totalRuns > teamB.totalRuns) {
+            std::cout << "\t----------------------------------\n";
+            std::cout << "\t|          TEAM A WINS!          |\n";
+            std::cout << "\t----------------------------------\n\n";
+        } else if (teamB.totalRuns > teamA.totalRuns) {
+            std::cout << "\t----------------------------------\n";
+            std::cout << "\t|          TEAM B WINS!          |\n";
+            std::cout << "\t----------------------------------\n\n";
+        } else {
+            std::cout << "\t----------------------------------\n";
+            std::cout << "\t|          MATCH DRAW!           |\n";
+            std::cout << "\t----------------------------------\n\n";
+        }
+
+        std::cout << "\tThank you for playing!\n\n";
+    }
+};
+
+#endif // CRICKET_GAME_H
@@ -0,0 +1,72 @@
+#ifndef CRICKET_GAME_POOL_H
+#define CRICKET_GAME_POOL_H
+
+#include <cstddef>
+#include <new>
+#include <vector>
+#include "game.h"
+
+// --- GamePool Class Definition ---
+// Fixed set of Game objects built once, side by side in one arena, and handed
+// out again and again. A Game's own buffers (player pool, line-ups) are sized
+// when it is built and a returned Game is only reset in place, so once the
+// pool exists, acquiring, playing and releasing matches never touches the heap.
+class GamePool {
+public:
+    // Constructor: builds 'capacity' Games up front
+    explicit GamePool(size_t capacity) :
+        numGames(capacity),
+        arena(static_cast<Game*>(::operator new(sizeof(Game) * capacity)))
+    {
+        for (size_t i = 0; i < capacity; ++i) {
+            new (arena + i) Game();
+        }
+        // Free list in reverse, so Games are handed out in arena order
+        freeList.reserve(capacity);
+        for (size_t i = capacity; i > 0; --i) {
+            freeList.push_back(arena + i - 1);
+        }
+    }
+
+    ~GamePool() {
+        for (size_t i = 0; i < numGames; ++i) {
+            arena[i].~Game();
+        }
+        ::operator delete(arena);
+    }
+
+    // Takes a Game with empty teams and zeroed counters; nullptr if all are in use
+    Game* acquire() {
+        if (freeList.empty()) {
+            return nullptr;
+        }
+        Game* game = freeList.back();
+        freeList.pop_back();
+        return game;
+    }
+
+    // Gives a Game back to the pool, clearing it for its next match
+    void release(Game* game) {
+        game->resetMatch();
+        freeList.push_back(game);
+    }
+
+    size_t capacity() const {
+        return numGames;
+    }
+
+    // Number of Games not currently handed out
+    size_t available() const {
+        return freeList.size();
+    }
+
+private:
+    size_t numGames;
+    Game* arena; // numGames Games, back to back
+    std::vector<Game*> freeList;
+
+    GamePool(const GamePool&) = delete;
+    GamePool& operator=(const GamePool&) = delete;
+};
+
+#endif // CRICKET_GAME_POOL_H
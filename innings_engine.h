@@ -0,0 +1,198 @@
+#ifndef CRICKET_INNINGS_ENGINE_H
+#define CRICKET_INNINGS_ENGINE_H
+
+#include <cstdint>
+#include <utility>  // For std::swap
+#include <vector>
+#include "game.h"
+#include "rng.h"
+#include "skill_model.h"
+
+// Outcomes of one delivery in the realistic innings model
+enum DeliveryOutcome {
+    DOT_BALL,
+    SINGLE,
+    TWO_RUNS,
+    THREE_RUNS,
+    FOUR_RUNS,
+    SIX_RUNS,
+    WIDE,
+    NO_BALL,
+    WICKET,
+    NUM_DELIVERY_OUTCOMES
+};
+
+const int BALLS_PER_OVER = 6;
+const int MAX_BOWLERS = 5; // Bowlers who share the overs (the last players of the bowling side)
+
+// Runs off the bat for each DeliveryOutcome
+inline int batRuns(int outcome) {
+    static const int runs[NUM_DELIVERY_OUTCOMES] = {0, 1, 2, 3, 4, 6, 0, 0, 0};
+    return runs[outcome];
+}
+
+// --- DeliveryModel Definition ---
+// How likely each delivery outcome is, and how a wicket falls, as alias tables
+struct DeliveryModel {
+    AliasTable<NUM_DELIVERY_OUTCOMES> outcomes;
+    AliasTable<NUM_DISMISSAL_KINDS> dismissals; // NOT_OUT has probability 0
+
+    // Constructor: probabilities indexed by DeliveryOutcome and by DismissalKind
+    DeliveryModel(const double* outcomeProbabilities, const double* dismissalProbabilities) {
+        outcomes.build(outcomeProbabilities);
+        dismissals.build(dismissalProbabilities);
+    }
+
+    // Rates close to a modern T20 innings: about 8 runs an over, a wicket every 22 balls
+    static DeliveryModel standard() {
+        const double outcomeProbabilities[NUM_DELIVERY_OUTCOMES] = {
+            0.35, 0.35, 0.07, 0.005, 0.10, 0.045, 0.03, 0.005, 0.045};
+        const double dismissalProbabilities[NUM_DISMISSAL_KINDS] = {0.0, 0.20, 0.55, 0.15, 0.07, 0.03};
+        return DeliveryModel(outcomeProbabilities, dismissalProbabilities);
+    }
+};
+
+// --- BallEvent Definition ---
+// One delivery as the engine played it, passed to the per-ball callback
+struct BallEvent {
+    int over;                // 0-based over of the innings
+    int legalBalls;          // Legal balls bowled in the innings, including this one
+    DeliveryOutcome outcome;
+    int batRuns;             // Runs credited to the striker
+    int extras;              // 1 for a wide or a no-ball
+    DismissalKind dismissal; // NOT_OUT unless outcome == WICKET
+    const Player* striker;
+    const Player* bowler;
+};
+
+// --- InningsEngine Class Definition ---
+// Plays a full innings on a Game's teams: two batsmen at the crease, strike
+// changing on odd runs and at the end of every over, overs shared by the last
+// MAX_BOWLERS players of the bowling side in rotation (no bowler twice in a row,
+// none over their limit), wides and no-balls that are not legal balls, and
+// wickets of several kinds (run outs are not credited to the bowler).
+// The state is a handful of indices into the batting order and the bowlers;
+// one 64-bit draw decides a delivery, and only wickets and no-balls draw again.
+class InningsEngine {
+public:
+    DeliveryModel model;
+
+    // Constructor
+    explicit InningsEngine(const DeliveryModel& model = DeliveryModel::standard()) :
+        model(model) {}
+
+    // Overs each of the sharing bowlers may bowl in an innings of 'maxDeliveries' balls
+    static int overLimit(int maxDeliveries, int bowlingSideSize) {
+        int overs = (maxDeliveries + BALLS_PER_OVER - 1) / BALLS_PER_OVER;
+        int bowlers = bowlingSideSize < MAX_BOWLERS ? bowlingSideSize : MAX_BOWLERS;
+        return bowlers > 0 ? (overs + bowlers - 1) / bowlers : 0;
+    }
+
+    // Plays innings 'inningsNumber' of 'game' (the toss already done) with no I/O.
+    // The innings ends after game.maxDeliveries legal balls, when only one batsman
+    // is left, or (in innings 2) as soon as the target is passed.
+    // onBall(const BallEvent&) is called after every delivery.
+    template <typename OnBall>
+    void playInnings(Game& game, int inningsNumber, OnBall onBall) {
+        CRICKET_PROFILE_PHASE(PHASE_INNINGS);
+        game.beginInnings(inningsNumber);
+        Team& batting = *game.battingTeam;
+        Team& bowling = *game.bowlingTeam;
+        int battingSize = static_cast<int>(batting.players.size());
+        int bowlingSize = static_cast<int>(bowling.players.size());
+        if (battingSize == 0 || bowlingSize == 0) {
+            return;
+        }
+
+        const bool chasing = (inningsNumber == 2);
+        const int target = bowling.totalRuns;
+        const int lastWicket = battingSize > 1 ? battingSize - 1 : 1;
+        const int numBowlers = bowlingSize < MAX_BOWLERS ? bowlingSize : MAX_BOWLERS;
+        const int firstBowler = bowlingSize - numBowlers;
+        const int limit = overLimit(game.maxDeliveries, bowlingSize);
+        oversBowled.assign(numBowlers, 0);
+
+        // A lone batsman is at both ends, so changing strike is a no-op
+        int striker = 0;
+        int nonStriker = battingSize > 1 ? 1 : 0;
+        int nextIn = 2;
+        int bowler = -1;
+        int legalBalls = 0;
+        bool finished = false;
+        Player* batsmen = batting.players.data();
+
+        for (int over = 0; legalBalls < game.maxDeliveries && !finished; ++over) {
+            bowler = nextBowler(bowler, numBowlers, limit);
+            oversBowled[bowler]++;
+            Player& currentBowler = bowling.players[firstBowler + bowler];
+            game.currentBowler = &currentBowler;
+            int overEnd = legalBalls + BALLS_PER_OVER < game.maxDeliveries ? legalBalls + BALLS_PER_OVER
+                                                                           : game.maxDeliveries;
+
+            while (legalBalls < overEnd && !finished) {
+                Player& batsman = batsmen[striker];
+                int outcome = model.outcomes.sample(game.rng.next());
+                int runs = batRuns(outcome);
+                int extras = (outcome == WIDE) | (outcome == NO_BALL);
+                int legal = 1 - extras;
+                if (outcome == NO_BALL) {
+                    runs = batRuns(model.outcomes.sample(game.rng.next())); // Hit off a no-ball; it cannot take a wicket
+                }
+
+                batsman.runsScored += runs;
+                batsman.ballsPlayed += (outcome != WIDE);
+                currentBowler.ballsBowled += legal;
+                currentBowler.runsGiven += runs + extras;
+                batting.totalRuns += runs + extras;
+                batting.extras += extras;
+                batting.totalBallsBowled += legal;
+                legalBalls += legal;
+
+                DismissalKind dismissal = NOT_OUT;
+                if (outcome == WICKET) {
+                    dismissal = static_cast<DismissalKind>(model.dismissals.sample(game.rng.next()));
+                    batsman.isOut = true;
+                    batsman.dismissal = dismissal;
+                    batting.totalWicketsLost++;
+                    currentBowler.wicketsTaken += (dismissal != RUN_OUT);
+                }
+
+                BallEvent event = {over, legalBalls, static_cast<DeliveryOutcome>(outcome), runs, extras, dismissal,
+                                   &batsman, &currentBowler};
+                onBall(event);
+
+                finished = batting.totalWicketsLost >= lastWicket || (chasing && batting.totalRuns > target);
+                if (outcome == WICKET && !finished) {
+                    striker = nextIn++; // The new batsman takes strike
+                }
+                if (runs & 1) {
+                    std::swap(striker, nonStriker);
+                }
+            }
+            std::swap(striker, nonStriker); // Change of ends
+        }
+        game.currentBatsman = batting.totalWicketsLost >= lastWicket ? nullptr : &batsmen[striker];
+    }
+
+    // Plays one innings with no per-ball callback
+    void playInnings(Game& game, int inningsNumber) {
+        playInnings(game, inningsNumber, [](const BallEvent&) {});
+    }
+
+private:
+    std::vector<int> oversBowled; // Overs bowled this innings by each sharing bowler (kept between innings)
+
+    // The next sharing bowler after 'previous' with overs left; the same bowler
+    // bowls again only if nobody else can
+    int nextBowler(int previous, int numBowlers, int limit) const {
+        for (int k = 1; k < numBowlers; ++k) {
+            int candidate = (previous + k) % numBowlers;
+            if (oversBowled[candidate] < limit) {
+                return candidate;
+            }
+        }
+        return previous >= 0 ? previous : 0;
+    }
+};
+
+#endif // CRICKET_INNINGS_ENGINE_H
@@ -0,0 +1,273 @@
+#include <iostream>
+#include <chrono>
+#include <cstdlib>  // For atoi() and atof()
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "live_protocol.h"
+
+// --- Load generator for the live match server ---
+// Opens many subscriber connections from one epoll thread, reads the update
+// stream on each and checks it: every ball must follow on from the score the
+// connection already knows (from the snapshot or earlier deltas).
+// Some connections can be made deliberately slow (never read) to exercise
+// the server's backpressure.
+
+// What one connection knows about one match
+struct MatchState {
+    int innings;
+    int ball;
+    int runs;
+    int wickets;
+};
+
+struct Connection {
+    int fd;
+    bool slow;
+    bool helloChecked = false;
+    size_t buffered = 0;
+    char partial[sizeof(LiveUpdate)];
+    std::unordered_map<uint32_t, MatchState> matches;
+    long long updates = 0;
+    long long inconsistencies = 0;
+    long long matchesEnded = 0;
+
+    // Constructor
+    Connection(int fd, bool slow) :
+        fd(fd),
+        slow(slow) {}
+};
+
+struct Totals {
+    long long updates = 0;
+    long long bytes = 0;
+    long long inconsistencies = 0;
+    long long matchesEnded = 0;
+    long long closedByServer = 0;
+    long long badHello = 0;
+};
+
+// Connects to "unix:PATH" or "HOST:PORT"; returns a non-blocking fd or -1
+int connectTo(const std::string& target) {
+    int fd;
+    if (target.compare(0, 5, "unix:") == 0) {
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, target.c_str() + 5, sizeof(address.sun_path) - 1);
+        fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+            if (fd >= 0) {
+                close(fd);
+            }
+            return -1;
+        }
+    } else {
+        size_t colon = target.rfind(':');
+        sockaddr_in address;
+        std::memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_port = htons(static_cast<uint16_t>(atoi(target.c_str() + colon + 1)));
+        std::string host = colon == std::string::npos ? "127.0.0.1" : target.substr(0, colon);
+        fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0 || inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1 ||
+            connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+            if (fd >= 0) {
+                close(fd);
+            }
+            return -1;
+        }
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    return fd;
+}
+
+// Applies one update to what the connection knows; counts updates that do not follow on
+void apply(Connection& connection, const LiveUpdate& update) {
+    connection.updates++;
+    switch (update.type) {
+    case LIVE_SNAPSHOT:
+        if (update.wicket) { // The batting side's score is the one deltas build on
+            connection.matches[update.matchId] = MatchState{update.innings, update.ball, update.totalRuns,
+                                                            update.totalWickets};
+        }
+        break;
+    case LIVE_MATCH_START:
+        connection.matches[update.matchId] = MatchState{0, 0, 0, 0};
+        break;
+    case LIVE_INNINGS_START:
+        connection.matches[update.matchId] = MatchState{update.innings, 0, 0, 0};
+        break;
+    case LIVE_BALL: {
+        auto it = connection.matches.find(update.matchId);
+        if (it == connection.matches.end()) {
+            connection.inconsistencies++;
+            break;
+        }
+        MatchState& state = it->second;
+        if (update.innings != state.innings || update.ball != state.ball + 1 ||
+            update.totalRuns != state.runs + update.runs || update.totalWickets != state.wickets + update.wicket) {
+            connection.inconsistencies++;
+        }
+        state = MatchState{update.innings, update.ball, update.totalRuns, update.totalWickets};
+        break;
+    }
+    case LIVE_MATCH_END:
+        connection.matches.erase(update.matchId);
+        connection.matchesEnded++;
+        break;
+    default:
+        connection.inconsistencies++;
+    }
+}
+
+// Reads everything waiting on a connection; returns false once the server has closed it
+bool readConnection(Connection& connection, Totals& totals) {
+    static char buffer[1 << 16];
+    while (true) {
+        ssize_t got = read(connection.fd, buffer, sizeof(buffer));
+        if (got == 0) {
+            return false;
+        }
+        if (got < 0) {
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        }
+        totals.bytes += got;
+        const char* p = buffer;
+        const char* end = buffer + got;
+        while (p < end) {
+            size_t take = std::min(static_cast<size_t>(end - p), sizeof(LiveUpdate) - connection.buffered);
+            std::memcpy(connection.partial + connection.buffered, p, take);
+            connection.buffered += take;
+            p += take;
+            if (connection.buffered < sizeof(LiveUpdate)) {
+                break;
+            }
+            connection.buffered = 0;
+            if (!connection.helloChecked) {
+                LiveHello hello;
+                std::memcpy(&hello, connection.partial, sizeof(hello));
+                if (!hello.isValid()) {
+                    totals.badHello++;
+                    return false;
+                }
+                connection.helloChecked = true;
+                continue;
+            }
+            LiveUpdate update;
+            std::memcpy(&update, connection.partial, sizeof(update));
+            apply(connection, update);
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " HOST:PORT|unix:PATH [--clients N] [--seconds S] [--slow K]\n";
+        return 1;
+    }
+    std::string target = argv[1];
+    int numClients = 100;
+    double seconds = 10;
+    int numSlow = 0;
+    for (int i = 2; i + 1 < argc; i += 2) {
+        std::string option = argv[i];
+        if (option == "--clients") {
+            numClients = atoi(argv[i + 1]);
+        } else if (option == "--seconds") {
+            seconds = atof(argv[i + 1]);
+        } else if (option == "--slow") {
+            numSlow = atoi(argv[i + 1]);
+        }
+    }
+
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    std::vector<std::unique_ptr<Connection>> connections;
+    for (int i = 0; i < numClients; ++i) {
+        int fd = connectTo(target);
+        if (fd < 0) {
+            std::cerr << "Connection " << i << " failed: " << std::strerror(errno) << "\n";
+            break;
+        }
+        int smallBuffer = 4096;
+        bool slow = i < numSlow;
+        if (slow) {
+            setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &smallBuffer, sizeof(smallBuffer));
+        }
+        connections.emplace_back(new Connection(fd, slow));
+        if (!slow) {
+            epoll_event event{};
+            event.events = EPOLLIN | EPOLLRDHUP;
+            event.data.u64 = connections.size() - 1;
+            epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+        }
+    }
+    if (connections.empty()) {
+        return 1;
+    }
+
+    Totals totals;
+    std::vector<epoll_event> events(1024);
+    auto start = std::chrono::steady_clock::now();
+    double elapsed = 0;
+    while ((elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()) < seconds) {
+        int ready = epoll_wait(epollFd, events.data(), static_cast<int>(events.size()), 100);
+        for (int i = 0; i < ready; ++i) {
+            Connection& connection = *connections[events[i].data.u64];
+            if (connection.fd >= 0 && !readConnection(connection, totals)) {
+                totals.closedByServer++;
+                epoll_ctl(epollFd, EPOLL_CTL_DEL, connection.fd, nullptr);
+                close(connection.fd);
+                connection.fd = -1;
+            }
+        }
+    }
+
+    // Slow connections find out here whether the server dropped them
+    long long slowDropped = 0;
+    for (auto& connection : connections) {
+        if (connection->slow) {
+            // Drain what the socket still holds to reach the server's close, if there was one
+            char drain[1 << 16];
+            ssize_t got;
+            while ((got = recv(connection->fd, drain, sizeof(drain), 0)) > 0) {
+            }
+            slowDropped += (got == 0 || (errno != EAGAIN && errno != EWOULDBLOCK));
+        }
+        totals.inconsistencies += connection->inconsistencies;
+        totals.updates += connection->updates;
+        totals.matchesEnded += connection->matchesEnded;
+        if (connection->fd >= 0) {
+            close(connection->fd);
+        }
+    }
+    close(epollFd);
+
+    long long fast = static_cast<long long>(connections.size()) - numSlow;
+    std::cout << "Connections: " << connections.size() << " (" << numSlow << " slow, " << slowDropped
+              << " of them dropped by the server)\n";
+    std::cout << "Closed by server: " << totals.closedByServer << ", bad hello: " << totals.badHello << "\n";
+    std::cout << "Updates: " << totals.updates << " (" << totals.updates / elapsed << " per second, "
+              << (fast > 0 ? totals.updates / elapsed / fast : 0) << " per connection)\n";
+    std::cout << "Bytes: " << totals.bytes << " (" << totals.bytes / elapsed / 1e6 << " MB/s)\n";
+    std::cout << "Match ends seen: " << totals.matchesEnded << "\n";
+    std::cout << "Inconsistent updates: " << totals.inconsistencies << "\n";
+    return totals.inconsistencies == 0 && totals.badHello == 0 ? 0 : 1;
+}
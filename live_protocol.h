@@ -0,0 +1,72 @@
+#ifndef CRICKET_LIVE_PROTOCOL_H
+#define CRICKET_LIVE_PROTOCOL_H
+
+#include <cstdint>
+#include <cstring>
+
+// --- Live Feed Wire Format ---
+// A subscriber receives one LiveHello, then a stream of fixed 16-byte
+// LiveUpdate records: first a snapshot of every match in progress, then the
+// deltas as they happen. All fields are little-endian (the host order of
+// every machine the server runs on); the client checks the magic and version.
+
+enum LiveUpdateType {
+    LIVE_SNAPSHOT = 1,      // One team's score in a match already under way (sent on connect)
+    LIVE_MATCH_START = 2,   // Toss done; battingTeam bats first
+    LIVE_INNINGS_START = 3, // Innings 'innings' begins; batsmanId and bowlerId open
+    LIVE_BALL = 4,          // One delivery
+    LIVE_MATCH_END = 5      // runs holds the result: 0 = draw, 1 = TeamA won, 2 = TeamB won
+};
+
+// --- LiveUpdate Definition ---
+struct LiveUpdate {
+    uint32_t matchId;
+    uint8_t type;         // LiveUpdateType
+    uint8_t innings;      // 1 or 2 (0 before the first innings)
+    uint16_t ball;        // Balls bowled in the innings after this update
+    uint8_t batsmanId;    // Player::id of the striker
+    uint8_t bowlerId;
+    uint8_t runs;         // Runs off this ball (or the result for LIVE_MATCH_END)
+    uint8_t wicket;       // 1 if the striker is out (for LIVE_SNAPSHOT: 1 if this team is batting)
+    uint16_t totalRuns;   // Batting team's score after this update (for LIVE_SNAPSHOT: this team's)
+    uint8_t totalWickets;
+    uint8_t battingTeam;  // 0 = TeamA, 1 = TeamB (for LIVE_SNAPSHOT: the team described)
+
+    static LiveUpdate make(uint32_t matchId, LiveUpdateType type, int innings, int battingTeam) {
+        LiveUpdate update;
+        std::memset(&update, 0, sizeof(update));
+        update.matchId = matchId;
+        update.type = static_cast<uint8_t>(type);
+        update.innings = static_cast<uint8_t>(innings);
+        update.battingTeam = static_cast<uint8_t>(battingTeam);
+        return update;
+    }
+};
+
+static_assert(sizeof(LiveUpdate) == 16, "LiveUpdate must stay 16 bytes");
+
+// --- LiveHello Definition ---
+// First 16 bytes a subscriber receives
+struct LiveHello {
+    char magic[8];       // "CRICLIVE"
+    uint32_t version;
+    uint32_t numChannels; // Matches played at the same time
+
+    static const uint32_t VERSION = 1;
+
+    static LiveHello make(int numChannels) {
+        LiveHello hello;
+        std::memcpy(hello.magic, "CRICLIVE", 8);
+        hello.version = VERSION;
+        hello.numChannels = static_cast<uint32_t>(numChannels);
+        return hello;
+    }
+
+    bool isValid() const {
+        return std::memcmp(magic, "CRICLIVE", 8) == 0 && version == VERSION;
+    }
+};
+
+static_assert(sizeof(LiveHello) == 16, "LiveHello must stay 16 bytes");
+
+#endif // CRICKET_LIVE_PROTOCOL_H
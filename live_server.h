@@ -0,0 +1,536 @@
+#ifndef CRICKET_LIVE_SERVER_H
+#define CRICKET_LIVE_SERVER_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <arpa/inet.h>  // For htons() and inet_pton()
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h> // For TCP_NODELAY
+#include <sys/epoll.h>
+#include <sys/resource.h> // For setrlimit()
+#include <sys/socket.h>
+#include <sys/uio.h>    // For iovec
+#include <sys/un.h>
+#include <unistd.h>
+#include "clock.h"
+#include "event_loop.h"
+#include "live_protocol.h"
+
+// --- BroadcastChunk Definition ---
+// A block of encoded updates shared by every subscriber that still has to
+// send it. Updates are written into a chunk once and never copied per
+// client: each client queue holds (chunk, offset) and the chunk goes back to
+// the free list when the last client has sent it. The server is single
+// threaded, so the count is a plain int.
+struct BroadcastChunk {
+    static const size_t CAPACITY = 64 * 1024 - 64;
+
+    int refs;
+    size_t size;
+    char data[CAPACITY];
+};
+
+// --- BroadcastPool Class Definition ---
+// Free list of chunks, so steady-state broadcasting does not touch the heap
+class BroadcastPool {
+public:
+    ~BroadcastPool() {
+        for (BroadcastChunk* chunk : freeChunks) {
+            delete chunk;
+        }
+    }
+
+    // An empty chunk with one reference (the caller's)
+    BroadcastChunk* acquire() {
+        BroadcastChunk* chunk;
+        if (freeChunks.empty()) {
+            chunk = new BroadcastChunk;
+            allocated++;
+        } else {
+            chunk = freeChunks.back();
+            freeChunks.pop_back();
+        }
+        chunk->refs = 1;
+        chunk->size = 0;
+        return chunk;
+    }
+
+    void retain(BroadcastChunk* chunk) {
+        chunk->refs++;
+    }
+
+    void release(BroadcastChunk* chunk) {
+        if (--chunk->refs == 0) {
+            freeChunks.push_back(chunk);
+        }
+    }
+
+    long long allocated = 0;
+
+private:
+    std::vector<BroadcastChunk*> freeChunks;
+};
+
+// --- LiveServer Class Definition ---
+// Plays 'numChannels' matches at once as PacedMatches on one EventLoop, with
+// virtual time driven by the wall clock times 'speed', and streams every
+// update to any number of TCP and Unix-socket subscribers from a single
+// epoll thread. When a match ends, its channel starts the next match index.
+//
+// Updates are gathered into a BroadcastChunk and handed to all subscribers
+// at most once per 'flushMicros' of real time. A subscriber more than
+// 'maxPendingBytes' behind is disconnected, so one slow reader can neither
+// stall the others nor grow the server's memory without bound.
+class LiveServer {
+public:
+    int numChannels;
+    uint64_t masterSeed;
+    double speed;                  // Virtual seconds per real second
+    long long flushMicros;         // Real time between broadcasts
+    size_t maxPendingBytes;        // Per-subscriber backpressure limit
+
+    // Counters reported by printStats()
+    long long updatesPublished = 0;
+    long long matchesFinished = 0;
+    long long clientsAccepted = 0;
+    long long clientsDropped = 0;  // Disconnected for falling too far behind
+    long long clientsClosed = 0;   // Went away on their own
+    long long bytesSent = 0;
+    size_t peakClients = 0;
+
+    // Constructor
+    LiveServer(int numChannels, uint64_t masterSeed, double speed) :
+        numChannels(numChannels),
+        masterSeed(masterSeed),
+        speed(speed > 0 ? speed : 1.0),
+        flushMicros(10000),
+        maxPendingBytes(4 * 1024 * 1024),
+        clock(Clock::instant()),
+        loop(clock),
+        epollFd(-1),
+        current(nullptr),
+        nextMatchIndex(0),
+        numClients(0)
+    {
+        raiseFileLimit();
+    }
+
+    ~LiveServer() {
+        for (size_t fd = 0; fd < clients.size(); ++fd) {
+            if (clients[fd]) {
+                closeClient(static_cast<int>(fd));
+            }
+        }
+        for (int fd : listeners) {
+            close(fd);
+        }
+        if (!unixPath.empty()) {
+            unlink(unixPath.c_str());
+        }
+        if (current) {
+            pool.release(current);
+        }
+        if (epollFd >= 0) {
+            close(epollFd);
+        }
+    }
+
+    // Listens on 127.0.0.1:'port'; returns false with a message in 'error' on failure
+    bool listenTcp(int port, std::string& error) {
+        int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        int yes = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+        sockaddr_in address;
+        std::memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_port = htons(static_cast<uint16_t>(port));
+        inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+        if (fd < 0 || bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+            listen(fd, SOMAXCONN) < 0) {
+            error = "cannot listen on port " + std::to_string(port) + ": " + std::strerror(errno);
+            if (fd >= 0) {
+                close(fd);
+            }
+            return false;
+        }
+        listeners.push_back(fd);
+        return true;
+    }
+
+    // Listens on a Unix socket at 'path' (replacing a stale one)
+    bool listenUnix(const std::string& path, std::string& error) {
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(address.sun_path)) {
+            error = "socket path too long: " + path;
+            return false;
+        }
+        std::strcpy(address.sun_path, path.c_str());
+        unlink(path.c_str());
+        int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0 || bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+            listen(fd, SOMAXCONN) < 0) {
+            error = "cannot listen on " + path + ": " + std::strerror(errno);
+            if (fd >= 0) {
+                close(fd);
+            }
+            return false;
+        }
+        listeners.push_back(fd);
+        unixPath = path;
+        return true;
+    }
+
+    // Serves until 'seconds' of real time have passed (0 = forever)
+    bool run(double seconds, std::string& error) {
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        if (epollFd < 0) {
+            error = std::string("epoll_create1: ") + std::strerror(errno);
+            return false;
+        }
+        for (size_t i = 0; i < listeners.size(); ++i) {
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.u64 = LISTENER_TAG | i;
+            epoll_ctl(epollFd, EPOLL_CTL_ADD, listeners[i], &event);
+        }
+        for (int channel = 0; channel < numChannels; ++channel) {
+            matches.emplace_back();
+            startMatch(channel);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        long long lastFlush = 0;
+        std::vector<epoll_event> events(1024);
+        while (true) {
+            long long realMicros = elapsedMicros(start);
+            if (seconds > 0 && realMicros >= seconds * 1e6) {
+                break;
+            }
+            loop.runUntil(static_cast<long long>(realMicros * speed));
+            restartFinishedMatches();
+            if (realMicros - lastFlush >= flushMicros) {
+                flush();
+                lastFlush = realMicros;
+            }
+
+            // Sleep until the next match event or broadcast, whichever comes first
+            long long waitMicros = flushMicros - (realMicros - lastFlush);
+            if (!loop.empty()) {
+                long long dueMicros = static_cast<long long>((loop.nextDueMicros() - clock.nowMicros) / speed);
+                waitMicros = std::min(waitMicros, dueMicros);
+            }
+            int timeoutMillis = static_cast<int>(std::max(0LL, (waitMicros + 999) / 1000));
+            int ready = epoll_wait(epollFd, events.data(), static_cast<int>(events.size()), timeoutMillis);
+            for (int i = 0; i < ready; ++i) {
+                handleEvent(events[i]);
+            }
+        }
+        flush();
+        return true;
+    }
+
+    void printStats(std::ostream& out) const {
+        out << "Matches finished: " << matchesFinished << "\n";
+        out << "Updates published: " << updatesPublished << "\n";
+        out << "Clients accepted: " << clientsAccepted << " (peak " << peakClients << " at once, "
+            << clientsClosed << " closed, " << clientsDropped << " dropped as too slow)\n";
+        out << "Bytes sent: " << bytesSent << "\n";
+        out << "Broadcast chunks allocated: " << pool.allocated << "\n";
+    }
+
+private:
+    static const uint64_t LISTENER_TAG = 1ULL << 63;
+    static const int MAX_IOVECS = 64;
+
+    // Part of a chunk still to be sent to one client
+    struct Segment {
+        BroadcastChunk* chunk;
+        size_t offset;
+    };
+
+    struct Client {
+        std::deque<Segment> queue;
+        size_t pendingBytes = 0;
+        size_t helloSent = 0;     // Bytes of the LiveHello written so far
+        bool subscribed = false;  // Has had its snapshot and receives broadcasts
+        bool waitingToWrite = false; // Registered for EPOLLOUT
+    };
+
+    Clock clock;
+    EventLoop loop;
+    int epollFd;
+    std::vector<int> listeners;
+    std::string unixPath;
+    std::vector<std::unique_ptr<PacedMatch>> matches; // One per channel
+    BroadcastPool pool;
+    BroadcastChunk* current; // Chunk being filled
+    long long nextMatchIndex;
+    std::vector<std::unique_ptr<Client>> clients; // Indexed by fd
+    std::vector<int> newClients; // Accepted, waiting for their snapshot at the next flush
+    size_t numClients;
+
+    static long long elapsedMicros(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start)
+            .count();
+    }
+
+    // Lets the server hold as many sockets as the hard limit allows
+    static void raiseFileLimit() {
+        rlimit limit;
+        if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+            limit.rlim_cur = limit.rlim_max;
+            setrlimit(RLIMIT_NOFILE, &limit);
+        }
+    }
+
+    void startMatch(int channel) {
+        matches[channel].reset(new PacedMatch(loop, masterSeed, nextMatchIndex++,
+                                              [this](const LiveUpdate& update) { append(update); }));
+        matches[channel]->start();
+    }
+
+    void restartFinishedMatches() {
+        for (int channel = 0; channel < numChannels; ++channel) {
+            if (matches[channel]->isFinished()) {
+                matchesFinished++;
+                startMatch(channel);
+            }
+        }
+    }
+
+    // Adds one update to the chunk being filled (the only copy it ever gets)
+    void append(const LiveUpdate& update) {
+        if (current != nullptr && current->size + sizeof(update) > BroadcastChunk::CAPACITY) {
+            broadcast(current);
+            current = nullptr;
+        }
+        if (current == nullptr) {
+            current = pool.acquire();
+        }
+        std::memcpy(current->data + current->size, &update, sizeof(update));
+        current->size += sizeof(update);
+        updatesPublished++;
+    }
+
+    // Hands the filled chunk to every subscriber, then sends new subscribers their snapshot
+    void flush() {
+        if (current != nullptr) {
+            broadcast(current);
+            current = nullptr;
+        }
+        if (newClients.empty()) {
+            return;
+        }
+
+        // One shared snapshot for everyone who joined since the last flush
+        std::vector<BroadcastChunk*> snapshot(1, pool.acquire());
+        for (const auto& match : matches) {
+            match->snapshot([this, &snapshot](const LiveUpdate& update) {
+                if (snapshot.back()->size + sizeof(update) > BroadcastChunk::CAPACITY) {
+                    snapshot.push_back(pool.acquire());
+                }
+                std::memcpy(snapshot.back()->data + snapshot.back()->size, &update, sizeof(update));
+                snapshot.back()->size += sizeof(update);
+            });
+        }
+        for (int fd : newClients) {
+            // A client closed before its flush can have its descriptor reused by a later
+            // accept, so the same fd can be listed twice: it gets one snapshot
+            if (!clients[fd] || clients[fd]->subscribed) {
+                continue;
+            }
+            clients[fd]->subscribed = true;
+            bool open = true;
+            for (size_t i = 0; i < snapshot.size() && open; ++i) {
+                open = enqueue(fd, snapshot[i]);
+            }
+            if (open) {
+                sendPending(fd); // Hello and snapshot
+            }
+        }
+        newClients.clear();
+        for (BroadcastChunk* chunk : snapshot) {
+            pool.release(chunk);
+        }
+    }
+
+    // Queues 'chunk' for every subscriber and writes to those not already waiting on EPOLLOUT;
+    // drops the caller's reference
+    void broadcast(BroadcastChunk* chunk) {
+        if (chunk->size > 0) {
+            for (int fd = 0; fd < static_cast<int>(clients.size()); ++fd) {
+                if (clients[fd] && clients[fd]->subscribed && enqueue(fd, chunk) && !clients[fd]->waitingToWrite) {
+                    sendPending(fd);
+                }
+            }
+        }
+        pool.release(chunk);
+    }
+
+    // Adds a reference to 'chunk' to one client's queue; returns false if that
+    // put the client over its backpressure limit and it was disconnected
+    bool enqueue(int fd, BroadcastChunk* chunk) {
+        Client& client = *clients[fd];
+        if (client.pendingBytes + chunk->size > maxPendingBytes) {
+            clientsDropped++;
+            closeClient(fd);
+            return false;
+        }
+        pool.retain(chunk);
+        client.queue.push_back(Segment{chunk, 0});
+        client.pendingBytes += chunk->size;
+        return true;
+    }
+
+    // Writes as much of the client's queue as the socket takes, straight from the shared chunks
+    void sendPending(int fd) {
+        Client& client = *clients[fd];
+        while (client.helloSent < sizeof(LiveHello)) {
+            LiveHello hello = LiveHello::make(numChannels);
+            ssize_t written = send(fd, reinterpret_cast<const char*>(&hello) + client.helloSent,
+                                   sizeof(hello) - client.helloSent, MSG_NOSIGNAL);
+            if (written < 0) {
+                handleWriteError(fd);
+                return;
+            }
+            client.helloSent += written;
+            bytesSent += written;
+        }
+        while (!client.queue.empty()) {
+            iovec vectors[MAX_IOVECS];
+            int count = 0;
+            for (auto it = client.queue.begin(); it != client.queue.end() && count < MAX_IOVECS; ++it, ++count) {
+                vectors[count].iov_base = it->chunk->data + it->offset;
+                vectors[count].iov_len = it->chunk->size - it->offset;
+            }
+            msghdr message;
+            std::memset(&message, 0, sizeof(message));
+            message.msg_iov = vectors;
+            message.msg_iovlen = count;
+            ssize_t written = sendmsg(fd, &message, MSG_NOSIGNAL); // A vanished peer is an error, not SIGPIPE
+            if (written < 0) {
+                handleWriteError(fd);
+                return;
+            }
+            bytesSent += written;
+            client.pendingBytes -= written;
+            size_t left = static_cast<size_t>(written);
+            while (left > 0) {
+                Segment& front = client.queue.front();
+                size_t remaining = front.chunk->size - front.offset;
+                if (left < remaining) {
+                    front.offset += left;
+                    break;
+                }
+                left -= remaining;
+                pool.release(front.chunk);
+                client.queue.pop_front();
+            }
+        }
+        setWaitingToWrite(fd, false);
+    }
+
+    void handleWriteError(int fd) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            setWaitingToWrite(fd, true);
+        } else if (errno != EINTR) {
+            clientsClosed++;
+            closeClient(fd);
+        }
+    }
+
+    // Asks epoll to report when the socket can take more (or stops asking)
+    void setWaitingToWrite(int fd, bool waiting) {
+        Client& client = *clients[fd];
+        if (client.waitingToWrite == waiting) {
+            return;
+        }
+        client.waitingToWrite = waiting;
+        uint32_t events = EPOLLIN | EPOLLRDHUP;
+        if (waiting) {
+            events |= EPOLLOUT;
+        }
+        epoll_event event{};
+        event.events = events;
+        event.data.u64 = static_cast<uint64_t>(fd);
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+    }
+
+    void handleEvent(const epoll_event& event) {
+        if (event.data.u64 & LISTENER_TAG) {
+            acceptClients(listeners[event.data.u64 & ~LISTENER_TAG]);
+            return;
+        }
+        int fd = static_cast<int>(event.data.u64);
+        if (fd >= static_cast<int>(clients.size()) || !clients[fd]) {
+            return;
+        }
+        if (event.events & (EPOLLERR | EPOLLHUP | EPOLLRDHUP)) {
+            clientsClosed++;
+            closeClient(fd);
+            return;
+        }
+        if (event.events & EPOLLIN) {
+            // Subscribers have nothing to say; read and discard so a closed peer is noticed
+            char discard[256];
+            ssize_t got = read(fd, discard, sizeof(discard));
+            if (got == 0 || (got < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                clientsClosed++;
+                closeClient(fd);
+                return;
+            }
+        }
+        if (event.events & EPOLLOUT) {
+            sendPending(fd);
+        }
+    }
+
+    void acceptClients(int listener) {
+        while (true) {
+            int fd = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                return; // EAGAIN: no more waiting, or out of descriptors until someone leaves
+            }
+            int yes = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes)); // Fails harmlessly on Unix sockets
+            if (fd >= static_cast<int>(clients.size())) {
+                clients.resize(fd + 1);
+            }
+            clients[fd].reset(new Client());
+            epoll_event event{};
+            event.events = EPOLLIN | EPOLLRDHUP;
+            event.data.u64 = static_cast<uint64_t>(fd);
+            epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+            newClients.push_back(fd);
+            clientsAccepted++;
+            numClients++;
+            peakClients = std::max(peakClients, numClients);
+        }
+    }
+
+    void closeClient(int fd) {
+        Client& client = *clients[fd];
+        for (const Segment& segment : client.queue) {
+            pool.release(segment.chunk);
+        }
+        if (epollFd >= 0) {
+            epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        }
+        close(fd);
+        clients[fd].reset();
+        numClients--;
+    }
+};
+
+#endif // CRICKET_LIVE_SERVER_H
@@ -0,0 +1,464 @@
+#ifndef CRICKET_LOCKSTEP_SIMULATOR_H
+#define CRICKET_LOCKSTEP_SIMULATOR_H
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include "match_format.h"
+#include "rng.h"
+#include "simulator.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CRICKET_LOCKSTEP_SIMD 1
+#endif
+
+// Which innings kernel a LockstepSimulator runs
+enum LockstepKernel {
+    LOCKSTEP_SCALAR, // One lane after another, branch per ball
+    LOCKSTEP_AVX2,   // Two groups of four lanes in 256-bit vectors
+    LOCKSTEP_AVX512  // Eight lanes in 512-bit vectors with mask registers
+};
+
+inline const char* lockstepKernelName(LockstepKernel kernel) {
+    static const char* const names[] = {"scalar", "AVX2", "AVX-512"};
+    return names[kernel];
+}
+
+// True if this machine can run 'kernel'
+inline bool lockstepKernelSupported(LockstepKernel kernel) {
+#ifdef CRICKET_LOCKSTEP_SIMD
+    if (kernel == LOCKSTEP_AVX512) {
+        static const bool supported = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+                                      __builtin_cpu_supports("popcnt");
+        return supported;
+    }
+    if (kernel == LOCKSTEP_AVX2) {
+        static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+        return supported;
+    }
+#endif
+    return kernel == LOCKSTEP_SCALAR;
+}
+
+// Widest kernel this machine can run
+inline LockstepKernel bestLockstepKernel() {
+    return lockstepKernelSupported(LOCKSTEP_AVX512) ? LOCKSTEP_AVX512
+           : lockstepKernelSupported(LOCKSTEP_AVX2) ? LOCKSTEP_AVX2
+                                                    : LOCKSTEP_SCALAR;
+}
+
+// --- LockstepSimulator Class Definition ---
+// FormatSimulator that plays matches eight at a time, one per lane, with the
+// innings of all eight advanced ball by ball in lockstep. Each lane keeps its
+// own SplitMix64 state, score, wickets and balls in one SIMD vector; a lane
+// whose innings is over (all out, balls used up, or target passed) is masked
+// off and stops drawing, so every match consumes exactly the draws of its own
+// RNG stream and the results are bit-identical to FormatSimulator's.
+//
+// The kernel has no data-dependent branches per ball. The generator state is
+// a counter (state += gamma), so it advances unmasked and each lane's true
+// state is recovered at the end from the balls it actually bowled; the mixes
+// of consecutive balls are then independent and overlap in the pipeline.
+// Wickets are not branched on either: the lanes that lost one are packed to
+// the front of a vector and appended to a wicket log (a compress on AVX-512,
+// a permute table on AVX2), from which each lane's batting card is rebuilt
+// after the innings. Lemire rejections (4 in 2^32
+// draws for 0-6) redraw that lane on the scalar path.
+template <typename Format>
+class LockstepSimulator : public FormatSimulator<Format> {
+    typedef FormatSimulator<Format> Base;
+    typedef typename Base::Innings Innings;
+
+public:
+    static const int balls = Format::balls;
+    static const int players = Format::players;
+    static const int LANES = 8;
+    static_assert(std::is_same<typename Format::Out, ZeroRunsOut>::value &&
+                      std::is_same<typename Format::Runs, UniformRuns>::value,
+                  "the lockstep kernels implement the Game's uniform 0-6 balls with out on 0");
+
+    LockstepKernel kernel; // Defaults to the widest the CPU supports
+
+    // Constructor
+    explicit LockstepSimulator(uint64_t masterSeed = 0) :
+        Base(masterSeed),
+        kernel(bestLockstepKernel()) {}
+
+    // Plays matches [first, last) into 'results', LANES at a time
+    void runRange(long long first, long long last, SimulationResults& results) const {
+        for (long long group = first; group < last; group += LANES) {
+            playGroup(group, static_cast<int>(std::min<long long>(LANES, last - group)), results);
+        }
+    }
+
+    // Plays 'numMatches' matches and returns the aggregate results
+    SimulationResults run(long long numMatches) const {
+        SimulationResults results = this->makeResults();
+        runRange(0, numMatches, results);
+        return results;
+    }
+
+private:
+    static const uint64_t GAMMA = 0x9E3779B97F4A7C15ULL; // Rng::next()'s increment
+    static const uint32_t BOUND = UniformRuns::maxRuns + 1;
+
+    // One innings of each lane; fallRuns/fallBalls[lane][w] are the score and balls
+    // when wicket w + 1 fell
+    struct alignas(64) LaneGroup {
+        uint64_t state[LANES];
+        int64_t runs[LANES];
+        int64_t wickets[LANES];
+        int64_t balls[LANES];
+        int64_t target[LANES];
+        int64_t fallRuns[LANES][players];
+        int64_t fallBalls[LANES][players];
+        int64_t wicketLog[LANES * players + LANES]; // packWicket() of every wicket, plus room for one vector store
+        int wicketCount;
+        int count; // Lanes in use
+    };
+
+    // A wicket of lane 'lane' at 'runs' after 'ball' balls, as one log entry
+    static int64_t packWicket(int64_t lane, int64_t runs, int64_t ball) {
+        return runs | (ball << 16) | (lane << 32);
+    }
+
+    // Fall of wickets of every lane from the wicket log (entries of a lane are in order)
+    static void readWicketLog(LaneGroup& group) {
+        int fallen[LANES] = {};
+        for (int i = 0; i < group.wicketCount; ++i) {
+            int64_t entry = group.wicketLog[i];
+            int lane = static_cast<int>(entry >> 32);
+            int wicket = fallen[lane]++;
+            group.fallRuns[lane][wicket] = entry & 0xFFFF;
+            group.fallBalls[lane][wicket] = (entry >> 16) & 0xFFFF;
+        }
+    }
+
+    // Plays matches [first, first + count) in the lanes of one group
+    void playGroup(long long first, int count, SimulationResults& results) const {
+        LaneGroup group;
+        group.count = count;
+        bool teamABatsFirst[LANES];
+        Innings firstInnings[LANES];
+        for (int lane = 0; lane < LANES; ++lane) {
+            Rng rng = Rng::forStream(this->masterSeed, first + lane);
+            teamABatsFirst[lane] = lane < count && Base::drawToss(rng);
+            group.state[lane] = rng.state;
+            group.target[lane] = 0;
+        }
+        playInnings<false>(group);
+        for (int lane = 0; lane < count; ++lane) {
+            readInnings(group, lane, firstInnings[lane]);
+            group.target[lane] = firstInnings[lane].runs;
+        }
+        playInnings<true>(group);
+        for (int lane = 0; lane < count; ++lane) {
+            Innings secondInnings;
+            readInnings(group, lane, secondInnings);
+            this->recordMatch(teamABatsFirst[lane], firstInnings[lane], secondInnings, results);
+        }
+    }
+
+    // Batting card of one lane's innings, rebuilt from the fall of wickets
+    static void readInnings(const LaneGroup& group, int lane, Innings& innings) {
+        innings.runs = static_cast<int>(group.runs[lane]);
+        innings.wickets = static_cast<int>(group.wickets[lane]);
+        innings.balls = static_cast<int>(group.balls[lane]);
+        int64_t runsBefore = 0;
+        int64_t ballsBefore = 0;
+        for (int i = 0; i < players; ++i) {
+            // Out batsmen end at their wicket, the not-out one at the close, the rest never bat
+            int64_t runsAfter = runsBefore;
+            int64_t ballsAfter = ballsBefore;
+            if (i < innings.wickets) {
+                runsAfter = group.fallRuns[lane][i];
+                ballsAfter = group.fallBalls[lane][i];
+            } else if (i == innings.wickets) {
+                runsAfter = group.runs[lane];
+                ballsAfter = group.balls[lane];
+            }
+            innings.batsmanRuns[i] = static_cast<int>(runsAfter - runsBefore);
+            innings.batsmanBalls[i] = static_cast<int>(ballsAfter - ballsBefore);
+            runsBefore = runsAfter;
+            ballsBefore = ballsAfter;
+        }
+    }
+
+    // Plays one innings in every lane in use, continuing each lane's RNG state; a
+    // chasing lane stops as soon as it passes its target
+    template <bool Chasing>
+    void playInnings(LaneGroup& group) const {
+        CRICKET_PROFILE_PHASE(PHASE_INNINGS);
+        for (int lane = 0; lane < LANES; ++lane) {
+            group.runs[lane] = 0;
+            group.wickets[lane] = 0;
+            group.balls[lane] = 0;
+        }
+        group.wicketCount = 0;
+#ifdef CRICKET_LOCKSTEP_SIMD
+        if (kernel == LOCKSTEP_AVX512) {
+            inningsAvx512<Chasing>(group);
+        } else if (kernel == LOCKSTEP_AVX2) {
+            inningsAvx2<Chasing>(group, 0);
+            inningsAvx2<Chasing>(group, 4);
+        } else
+#endif
+        {
+            inningsScalar<Chasing>(group);
+        }
+        readWicketLog(group);
+    }
+
+    // Scalar kernel: each lane's innings in turn, as FormatSimulator plays it
+    template <bool Chasing>
+    static void inningsScalar(LaneGroup& group) {
+        for (int lane = 0; lane < group.count; ++lane) {
+            Rng rng(group.state[lane]);
+            int64_t runs = 0;
+            int64_t wickets = 0;
+            int64_t ball = 0;
+            while (ball < balls) {
+                int64_t drawn = rng.below(BOUND);
+                runs += drawn;
+                ++ball;
+                if (drawn == 0) {
+                    group.wicketLog[group.wicketCount++] = packWicket(lane, runs, ball);
+                    if (++wickets == players) {
+                        break;
+                    }
+                }
+                if (Chasing && runs > group.target[lane]) {
+                    break;
+                }
+            }
+            group.state[lane] = rng.state;
+            group.runs[lane] = runs;
+            group.wickets[lane] = wickets;
+            group.balls[lane] = ball;
+        }
+    }
+
+    // A rejected Lemire draw of one lane, redrawn as Rng::below() would: updates the
+    // lane's state and returns its 64-bit product
+    static uint64_t redraw(uint64_t& state) {
+        Rng rng(state);
+        uint64_t product;
+        do {
+            product = static_cast<uint64_t>(static_cast<uint32_t>(rng.next() >> 32)) * BOUND;
+        } while (static_cast<uint32_t>(product) < (-BOUND % BOUND));
+        state = rng.state;
+        return product;
+    }
+
+#ifdef CRICKET_LOCKSTEP_SIMD
+    // Eight lanes in 512-bit vectors; lanes are active while bit 'lane' of 'active' is set
+    template <bool Chasing>
+    __attribute__((target("avx512f,avx512dq,popcnt"))) static void inningsAvx512(LaneGroup& group) {
+        const __m512i gamma = _mm512_set1_epi64(static_cast<long long>(GAMMA));
+        const __m512i bound = _mm512_set1_epi64(BOUND);
+        const __m512i threshold = _mm512_set1_epi64(-BOUND % BOUND);
+        const __m512i low32 = _mm512_set1_epi64(0xFFFFFFFFLL);
+        const __m512i one = _mm512_set1_epi64(1);
+        const __m512i zero = _mm512_setzero_si512();
+        const __m512i allOut = _mm512_set1_epi64(players);
+        const __m512i laneTags = _mm512_slli_epi64(_mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7), 32);
+        const __m512i target = _mm512_load_si512(group.target);
+        __m512i state = _mm512_load_si512(group.state);
+        __m512i runs = zero;
+        __m512i wickets = zero;
+        __m512i ballsBowled = zero;
+        __mmask8 active = static_cast<__mmask8>((1u << group.count) - 1);
+        int logged = 0;
+
+        int steps = 0;
+        for (; steps < balls && active; ++steps) {
+            // Rng::below(7) in every lane: next() is the SplitMix64 finalizer of state + gamma
+            state = _mm512_add_epi64(state, gamma);
+            __m512i z = state;
+            z = _mm512_mullo_epi64(_mm512_xor_si512(z, _mm512_srli_epi64(z, 30)),
+                                   _mm512_set1_epi64(static_cast<long long>(0xBF58476D1CE4E5B9ULL)));
+            z = _mm512_mullo_epi64(_mm512_xor_si512(z, _mm512_srli_epi64(z, 27)),
+                                   _mm512_set1_epi64(static_cast<long long>(0x94D049BB133111EBULL)));
+            z = _mm512_xor_si512(z, _mm512_srli_epi64(z, 31));
+            __m512i product = _mm512_mul_epu32(_mm512_srli_epi64(z, 32), bound);
+            __mmask8 rejected = _mm512_mask_cmplt_epu64_mask(active, _mm512_and_si512(product, low32), threshold);
+            if (rejected) {
+                alignas(64) uint64_t states[LANES];
+                alignas(64) uint64_t products[LANES];
+                _mm512_store_si512(states, state);
+                _mm512_store_si512(products, product);
+                for (int lane = 0; lane < LANES; ++lane) {
+                    if ((rejected >> lane) & 1) {
+                        products[lane] = redraw(states[lane]);
+                    }
+                }
+                state = _mm512_load_si512(states);
+                product = _mm512_load_si512(products);
+            }
+            __m512i drawn = _mm512_srli_epi64(product, 32);
+
+            // Masked updates: only active lanes score, use a ball or lose a wicket
+            __mmask8 out = _mm512_mask_cmpeq_epi64_mask(active, drawn, zero);
+            runs = _mm512_mask_add_epi64(runs, active, runs, drawn);
+            ballsBowled = _mm512_mask_add_epi64(ballsBowled, active, ballsBowled, one);
+            __m512i entries = _mm512_or_si512(_mm512_or_si512(runs, _mm512_slli_epi64(ballsBowled, 16)), laneTags);
+            _mm512_storeu_si512(group.wicketLog + logged, _mm512_maskz_compress_epi64(out, entries));
+            logged += __builtin_popcount(out);
+            wickets = _mm512_mask_add_epi64(wickets, out, wickets, one);
+            active = _mm512_mask_cmpneq_epi64_mask(active, wickets, allOut);
+            if (Chasing) {
+                active = _mm512_mask_cmple_epi64_mask(active, runs, target);
+            }
+        }
+
+        // Lanes that finished early kept stepping their state; take those steps back
+        __m512i idle = _mm512_sub_epi64(_mm512_set1_epi64(steps), ballsBowled);
+        state = _mm512_sub_epi64(state, _mm512_mullo_epi64(idle, gamma));
+        _mm512_store_si512(group.state, state);
+        _mm512_store_si512(group.runs, runs);
+        _mm512_store_si512(group.wickets, wickets);
+        _mm512_store_si512(group.balls, ballsBowled);
+        group.wicketCount = logged;
+    }
+
+    // For each 4-bit lane mask, the 32-bit permutation that moves the selected 64-bit lanes
+    // to the front in order (AVX2 has no compress)
+    struct LeftPackTable {
+        alignas(32) int32_t indices[16][8];
+
+        LeftPackTable() {
+            for (int mask = 0; mask < 16; ++mask) {
+                int packed = 0;
+                for (int lane = 0; lane < 4; ++lane) {
+                    if ((mask >> lane) & 1) {
+                        indices[mask][2 * packed] = 2 * lane;
+                        indices[mask][2 * packed + 1] = 2 * lane + 1;
+                        ++packed;
+                    }
+                }
+                for (; packed < 4; ++packed) {
+                    indices[mask][2 * packed] = 0;
+                    indices[mask][2 * packed + 1] = 1;
+                }
+            }
+        }
+    };
+
+    static const LeftPackTable& leftPackTable() {
+        static const LeftPackTable table;
+        return table;
+    }
+
+    // Low 64 bits of the four products a[i] * b[i] (AVX2 has no 64-bit multiply)
+    __attribute__((target("avx2"))) static __m256i mullo64(__m256i a, __m256i b) {
+        __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+                                         _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+        return _mm256_add_epi64(_mm256_mul_epu32(a, b), _mm256_slli_epi64(cross, 32));
+    }
+
+    // Lanes [first, first + 4) in 256-bit vectors; an active lane is all ones in 'active'
+    template <bool Chasing>
+    __attribute__((target("avx2,popcnt"))) static void inningsAvx2(LaneGroup& group, int first) {
+        if (first >= group.count) {
+            return;
+        }
+        const __m256i gamma = _mm256_set1_epi64x(static_cast<long long>(GAMMA));
+        const __m256i mix1 = _mm256_set1_epi64x(static_cast<long long>(0xBF58476D1CE4E5B9ULL));
+        const __m256i mix2 = _mm256_set1_epi64x(static_cast<long long>(0x94D049BB133111EBULL));
+        const __m256i bound = _mm256_set1_epi64x(BOUND);
+        const __m256i threshold = _mm256_set1_epi64x(-BOUND % BOUND);
+        const __m256i low32 = _mm256_set1_epi64x(0xFFFFFFFFLL);
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i allOut = _mm256_set1_epi64x(players);
+        const __m256i target = _mm256_load_si256(reinterpret_cast<const __m256i*>(group.target + first));
+        __m256i state = _mm256_load_si256(reinterpret_cast<const __m256i*>(group.state + first));
+        __m256i runs = zero;
+        __m256i wickets = zero;
+        __m256i ballsBowled = zero;
+        const __m256i lanes = _mm256_setr_epi64x(0, 1, 2, 3);
+        const __m256i laneTags = _mm256_slli_epi64(_mm256_add_epi64(lanes, _mm256_set1_epi64x(first)), 32);
+        const LeftPackTable& leftPack = leftPackTable();
+        __m256i active = _mm256_cmpgt_epi64(_mm256_set1_epi64x(group.count - first), lanes);
+        int logged = group.wicketCount;
+
+        int steps = 0;
+        for (; steps < balls && _mm256_movemask_pd(_mm256_castsi256_pd(active)); ++steps) {
+            state = _mm256_add_epi64(state, gamma);
+            __m256i z = state;
+            z = mullo64(_mm256_xor_si256(z, _mm256_srli_epi64(z, 30)), mix1);
+            z = mullo64(_mm256_xor_si256(z, _mm256_srli_epi64(z, 27)), mix2);
+            z = _mm256_xor_si256(z, _mm256_srli_epi64(z, 31));
+            __m256i product = _mm256_mul_epu32(_mm256_srli_epi64(z, 32), bound);
+            __m256i rejected = _mm256_and_si256(active, _mm256_cmpgt_epi64(threshold, _mm256_and_si256(product, low32)));
+            int rejectMask = _mm256_movemask_pd(_mm256_castsi256_pd(rejected));
+            if (rejectMask) {
+                alignas(32) uint64_t states[4];
+                alignas(32) uint64_t products[4];
+                _mm256_store_si256(reinterpret_cast<__m256i*>(states), state);
+                _mm256_store_si256(reinterpret_cast<__m256i*>(products), product);
+                for (int lane = 0; lane < 4; ++lane) {
+                    if ((rejectMask >> lane) & 1) {
+                        products[lane] = redraw(states[lane]);
+                    }
+                }
+                state = _mm256_load_si256(reinterpret_cast<const __m256i*>(states));
+                product = _mm256_load_si256(reinterpret_cast<const __m256i*>(products));
+            }
+            __m256i drawn = _mm256_srli_epi64(product, 32);
+
+            __m256i out = _mm256_and_si256(active, _mm256_cmpeq_epi64(drawn, zero));
+            runs = _mm256_add_epi64(runs, _mm256_and_si256(drawn, active));
+            ballsBowled = _mm256_sub_epi64(ballsBowled, active); // Active lanes are -1
+            int outMask = _mm256_movemask_pd(_mm256_castsi256_pd(out));
+            __m256i entries = _mm256_or_si256(_mm256_or_si256(runs, _mm256_slli_epi64(ballsBowled, 16)), laneTags);
+            __m256i packed = _mm256_permutevar8x32_epi32(
+                entries, _mm256_load_si256(reinterpret_cast<const __m256i*>(leftPack.indices[outMask])));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(group.wicketLog + logged), packed);
+            logged += __builtin_popcount(outMask);
+            wickets = _mm256_sub_epi64(wickets, out);
+            active = _mm256_andnot_si256(_mm256_cmpeq_epi64(wickets, allOut), active);
+            if (Chasing) {
+                active = _mm256_andnot_si256(_mm256_cmpgt_epi64(runs, target), active);
+            }
+        }
+
+        __m256i idle = _mm256_sub_epi64(_mm256_set1_epi64x(steps), ballsBowled);
+        state = _mm256_sub_epi64(state, mullo64(idle, gamma));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(group.state + first), state);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(group.runs + first), runs);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(group.wickets + first), wickets);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(group.balls + first), ballsBowled);
+        group.wicketCount = logged;
+    }
+#endif
+};
+
+// Runs 'numMatches' matches of one compile-time format on the lockstep kernel across threads
+template <typename Format>
+SimulationResults runLockstep(uint64_t masterSeed, int numThreads, long long numMatches) {
+    ParallelRunner<LockstepSimulator<Format>> runner(masterSeed, numThreads);
+    return runner.run(numMatches);
+}
+
+// Lockstep counterpart of FormatEntry::run for the formats of formatTable(); nullptr if none
+typedef SimulationResults (*LockstepRunFunction)(uint64_t masterSeed, int numThreads, long long numMatches);
+
+inline LockstepRunFunction findLockstep(int balls, int players) {
+    static const struct {
+        int balls;
+        int players;
+        LockstepRunFunction run;
+    } table[] = {
+        {OneOverFormat::balls, OneOverFormat::players, &runLockstep<OneOverFormat>},
+        {T20Format::balls, T20Format::players, &runLockstep<T20Format>},
+        {OdiFormat::balls, OdiFormat::players, &runLockstep<OdiFormat>},
+    };
+    for (const auto& entry : table) {
+        if (entry.balls == balls && entry.players == players) {
+            return entry.run;
+        }
+    }
+    return nullptr;
+}
+
+#endif // CRICKET_LOCKSTEP_SIMULATOR_H
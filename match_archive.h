@@ -0,0 +1,308 @@
+#ifndef CRICKET_MATCH_ARCHIVE_H
+#define CRICKET_MATCH_ARCHIVE_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <fcntl.h>    // For open()
+#include <sys/mman.h> // For mmap()
+#include <sys/stat.h> // For fstat()
+#include <unistd.h>   // For ftruncate() and close()
+#include "event_log.h"
+
+// Columns of a MatchArchive: one value per delivery, then one per match
+enum ArchiveColumn {
+    DELIVERY_BATSMAN,     // uint8_t Player::id
+    DELIVERY_BOWLER,      // uint8_t Player::id
+    DELIVERY_RUNS,        // uint8_t
+    DELIVERY_WICKET,      // uint8_t 0 or 1
+    DELIVERY_INNINGS,     // uint8_t 1 or 2
+    MATCH_ID,             // uint32_t
+    MATCH_FIRST_DELIVERY, // uint64_t, with one extra entry holding the delivery count
+    MATCH_TEAM_A_RUNS,    // uint16_t
+    MATCH_TEAM_B_RUNS,    // uint16_t
+    MATCH_RESULT,         // uint8_t MatchResult
+    MATCH_TEAM_A_FIRST,   // uint8_t 1 if TeamA batted first
+    MATCH_OPENER,         // uint8_t Player::id who faced the first ball of innings 1
+    MATCH_CHASE_OPENER,   // uint8_t Player::id who faced the first ball of innings 2
+    NUM_ARCHIVE_COLUMNS
+};
+
+// Values of the MATCH_RESULT column
+enum MatchResult {
+    RESULT_DRAW,
+    RESULT_TEAM_A_WIN,
+    RESULT_TEAM_B_WIN
+};
+
+// Bytes per value of each column
+inline size_t archiveColumnWidth(ArchiveColumn column) {
+    switch (column) {
+    case MATCH_ID:
+        return sizeof(uint32_t);
+    case MATCH_FIRST_DELIVERY:
+        return sizeof(uint64_t);
+    case MATCH_TEAM_A_RUNS:
+    case MATCH_TEAM_B_RUNS:
+        return sizeof(uint16_t);
+    default:
+        return sizeof(uint8_t);
+    }
+}
+
+// --- ArchiveHeader Definition ---
+// Start of every archive file: counts, the log header the archive was built
+// from (format and line-ups) and the byte offset of every column.
+struct ArchiveHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t numDeliveries;
+    uint64_t numMatches;
+    EventLogHeader log;
+    uint64_t columnOffsets[NUM_ARCHIVE_COLUMNS];
+
+    static const uint32_t VERSION = 2; // 2: sides from the logged toss
+
+    bool isValid() const {
+        return std::memcmp(magic, "CRICKARC", 8) == 0 && version == VERSION && log.isValid();
+    }
+
+    // Number of values in a column
+    uint64_t columnLength(ArchiveColumn column) const {
+        if (column < MATCH_ID) {
+            return numDeliveries;
+        }
+        return column == MATCH_FIRST_DELIVERY ? numMatches + 1 : numMatches;
+    }
+};
+
+// --- MatchArchive Class Definition ---
+// Read-only columnar view of a delivery log. Every column is a plain array in
+// one memory-mapped file, so scans read the values they need straight from the
+// page cache, and each column is 64-byte aligned for vector loads.
+class MatchArchive {
+public:
+    const ArchiveHeader* header;
+    size_t numDeliveries;
+    size_t numMatches;
+
+    // Delivery columns
+    const uint8_t* batsmanIds;
+    const uint8_t* bowlerIds;
+    const uint8_t* runs;
+    const uint8_t* wickets;
+    const uint8_t* innings;
+
+    // Match columns
+    const uint32_t* matchIds;
+    const uint64_t* firstDeliveries;
+    const uint16_t* teamARuns;
+    const uint16_t* teamBRuns;
+    const uint8_t* results;
+    const uint8_t* teamABattedFirst;
+    const uint8_t* openers;
+    const uint8_t* chaseOpeners;
+
+    MatchArchive() :
+        mapping(nullptr),
+        mappedSize(0)
+    {
+        clearColumns();
+    }
+
+    ~MatchArchive() {
+        close();
+    }
+
+    // Converts an event log into an archive at 'path'; returns false on failure
+    static bool build(const EventLogReader& log, const std::string& path) {
+        ArchiveHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, "CRICKARC", 8);
+        header.version = ArchiveHeader::VERSION;
+        header.log = *log.header;
+        header.numDeliveries = log.numRecords;
+        for (size_t i = 0; i < log.numRecords; i++) {
+            header.numMatches += (i == 0 || log.records[i].matchId != log.records[i - 1].matchId);
+        }
+        uint64_t size = layout(header);
+
+        int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            return false;
+        }
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            ::close(fd);
+            return false;
+        }
+        void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (address == MAP_FAILED) {
+            return false;
+        }
+        char* base = static_cast<char*>(address);
+        std::memcpy(base, &header, sizeof(header));
+        fill(log, header, base);
+        bool synced = msync(address, size, MS_SYNC) == 0;
+        munmap(address, size);
+        return synced;
+    }
+
+    // Maps 'path'; returns false if it cannot be read or is not an archive
+    bool open(const std::string& path) {
+        close();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(ArchiveHeader)) {
+            ::close(fd);
+            return false;
+        }
+        mappedSize = info.st_size;
+        void* address = mmap(nullptr, mappedSize, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (address == MAP_FAILED) {
+            mappedSize = 0;
+            return false;
+        }
+        mapping = address;
+        header = static_cast<const ArchiveHeader*>(mapping);
+        if (!header->isValid() || !columnsFit()) {
+            close();
+            return false;
+        }
+        numDeliveries = header->numDeliveries;
+        numMatches = header->numMatches;
+        batsmanIds = column<uint8_t>(DELIVERY_BATSMAN);
+        bowlerIds = column<uint8_t>(DELIVERY_BOWLER);
+        runs = column<uint8_t>(DELIVERY_RUNS);
+        wickets = column<uint8_t>(DELIVERY_WICKET);
+        innings = column<uint8_t>(DELIVERY_INNINGS);
+        matchIds = column<uint32_t>(MATCH_ID);
+        firstDeliveries = column<uint64_t>(MATCH_FIRST_DELIVERY);
+        teamARuns = column<uint16_t>(MATCH_TEAM_A_RUNS);
+        teamBRuns = column<uint16_t>(MATCH_TEAM_B_RUNS);
+        results = column<uint8_t>(MATCH_RESULT);
+        teamABattedFirst = column<uint8_t>(MATCH_TEAM_A_FIRST);
+        openers = column<uint8_t>(MATCH_OPENER);
+        chaseOpeners = column<uint8_t>(MATCH_CHASE_OPENER);
+        return true;
+    }
+
+    void close() {
+        if (mapping != nullptr) {
+            munmap(mapping, mappedSize);
+        }
+        mapping = nullptr;
+        mappedSize = 0;
+        clearColumns();
+    }
+
+private:
+    void* mapping;
+    size_t mappedSize;
+
+    MatchArchive(const MatchArchive&) = delete;
+    MatchArchive& operator=(const MatchArchive&) = delete;
+
+    void clearColumns() {
+        header = nullptr;
+        numDeliveries = 0;
+        numMatches = 0;
+        batsmanIds = bowlerIds = runs = wickets = innings = nullptr;
+        matchIds = nullptr;
+        firstDeliveries = nullptr;
+        teamARuns = teamBRuns = nullptr;
+        results = teamABattedFirst = openers = chaseOpeners = nullptr;
+    }
+
+    template <typename T>
+    const T* column(ArchiveColumn column) const {
+        return reinterpret_cast<const T*>(static_cast<const char*>(mapping) + header->columnOffsets[column]);
+    }
+
+    // True if every column lies inside the mapped file
+    bool columnsFit() const {
+        for (int c = 0; c < NUM_ARCHIVE_COLUMNS; ++c) {
+            ArchiveColumn column = static_cast<ArchiveColumn>(c);
+            uint64_t bytes = header->columnLength(column) * archiveColumnWidth(column);
+            if (header->columnOffsets[c] > mappedSize || bytes > mappedSize - header->columnOffsets[c]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Places every column after the header on a 64-byte boundary; returns the file size
+    static uint64_t layout(ArchiveHeader& header) {
+        uint64_t offset = sizeof(ArchiveHeader);
+        for (int c = 0; c < NUM_ARCHIVE_COLUMNS; ++c) {
+            ArchiveColumn column = static_cast<ArchiveColumn>(c);
+            offset = (offset + 63) & ~static_cast<uint64_t>(63);
+            header.columnOffsets[c] = offset;
+            offset += header.columnLength(column) * archiveColumnWidth(column);
+        }
+        return offset;
+    }
+
+    // Splits the log's records into columns and derives the match columns
+    static void fill(const EventLogReader& log, const ArchiveHeader& header, char* base) {
+        uint8_t* batsmen = reinterpret_cast<uint8_t*>(base + header.columnOffsets[DELIVERY_BATSMAN]);
+        uint8_t* bowlers = reinterpret_cast<uint8_t*>(base + header.columnOffsets[DELIVERY_BOWLER]);
+        uint8_t* deliveryRuns = reinterpret_cast<uint8_t*>(base + header.columnOffsets[DELIVERY_RUNS]);
+        uint8_t* deliveryWickets = reinterpret_cast<uint8_t*>(base + header.columnOffsets[DELIVERY_WICKET]);
+        uint8_t* deliveryInnings = reinterpret_cast<uint8_t*>(base + header.columnOffsets[DELIVERY_INNINGS]);
+        uint32_t* ids = reinterpret_cast<uint32_t*>(base + header.columnOffsets[MATCH_ID]);
+        uint64_t* first = reinterpret_cast<uint64_t*>(base + header.columnOffsets[MATCH_FIRST_DELIVERY]);
+        uint16_t* aRuns = reinterpret_cast<uint16_t*>(base + header.columnOffsets[MATCH_TEAM_A_RUNS]);
+        uint16_t* bRuns = reinterpret_cast<uint16_t*>(base + header.columnOffsets[MATCH_TEAM_B_RUNS]);
+        uint8_t* matchResults = reinterpret_cast<uint8_t*>(base + header.columnOffsets[MATCH_RESULT]);
+        uint8_t* aFirst = reinterpret_cast<uint8_t*>(base + header.columnOffsets[MATCH_TEAM_A_FIRST]);
+        uint8_t* matchOpeners = reinterpret_cast<uint8_t*>(base + header.columnOffsets[MATCH_OPENER]);
+        uint8_t* matchChaseOpeners = reinterpret_cast<uint8_t*>(base + header.columnOffsets[MATCH_CHASE_OPENER]);
+
+        // The batting side comes from the logged toss and the innings, not the batsman's id:
+        // 11-a-side line-ups share players, so an id can be in both teams
+        size_t m = 0;
+        for (size_t i = 0; i < log.numRecords; ++i) {
+            const DeliveryRecord& record = log.records[i];
+            batsmen[i] = record.batsmanId;
+            bowlers[i] = record.bowlerId;
+            deliveryRuns[i] = static_cast<uint8_t>(record.runs());
+            deliveryWickets[i] = record.wicket();
+            deliveryInnings[i] = static_cast<uint8_t>(record.innings());
+
+            if (i == 0 || record.matchId != log.records[i - 1].matchId) {
+                if (i > 0) {
+                    m++;
+                }
+                ids[m] = record.matchId;
+                first[m] = i;
+                aRuns[m] = 0;
+                bRuns[m] = 0;
+                aFirst[m] = record.teamABatsFirst();
+                matchOpeners[m] = record.batsmanId;
+                matchChaseOpeners[m] = 0;
+            }
+            if (record.innings() == 2 && matchChaseOpeners[m] == 0) {
+                matchChaseOpeners[m] = record.batsmanId;
+            }
+            if (record.teamABatting()) {
+                aRuns[m] += record.runs();
+            } else {
+                bRuns[m] += record.runs();
+            }
+        }
+        first[header.numMatches] = log.numRecords;
+        for (size_t i = 0; i < header.numMatches; ++i) {
+            matchResults[i] = aRuns[i] > bRuns[i] ? RESULT_TEAM_A_WIN
+                              : bRuns[i] > aRuns[i] ? RESULT_TEAM_B_WIN
+                                                    : RESULT_DRAW;
+        }
+    }
+};
+
+#endif // CRICKET_MATCH_ARCHIVE_H
@@ -0,0 +1,71 @@
+#ifndef CRICKET_MATCH_FORK_H
+#define CRICKET_MATCH_FORK_H
+
+#include <cstdint>
+#include <iostream>
+#include "game.h"
+#include "match_state.h"
+#include "rng.h"
+
+// --- ForkOdds Definition ---
+// How many continuations of one match state each side won
+struct ForkOdds {
+    long long forks = 0;
+    long long teamAWins = 0;
+    long long teamBWins = 0;
+    long long draws = 0;
+
+    // Adds the counts of another batch of forks
+    void merge(const ForkOdds& other) {
+        forks += other.forks;
+        teamAWins += other.teamAWins;
+        teamBWins += other.teamBWins;
+        draws += other.draws;
+    }
+
+    // Prints the win/draw rates over all forks
+    void print(std::ostream& out) const {
+        double n = forks > 0 ? static_cast<double>(forks) : 1.0;
+        out << "Forks: " << forks << "\n";
+        out << "TeamA win rate: " << teamAWins / n << "\n";
+        out << "TeamB win rate: " << teamBWins / n << "\n";
+        out << "Draw rate: " << draws / n << "\n";
+    }
+};
+
+// --- MatchForker Class Definition ---
+// Plays many continuations of one saved MatchState to the end, fork k on RNG
+// stream k of forkSeed, so a batch of forks is reproducible. The Game keeps
+// its line-ups between forks, so restoring a fork only overwrites counters
+// and never touches the heap.
+class MatchForker {
+public:
+    Game game;
+    uint64_t forkSeed;
+
+    // Constructor
+    explicit MatchForker(uint64_t forkSeed = 0) :
+        forkSeed(forkSeed) {}
+
+    // Plays forks [first, last) of 'state' into 'odds'; false if the state does not fit the pool
+    bool run(const MatchState& state, long long first, long long last, ForkOdds& odds) {
+        for (long long k = first; k < last; ++k) {
+            if (!game.restoreState(state)) {
+                return false;
+            }
+            game.rng = Rng::forStream(forkSeed, k);
+            game.playToEnd();
+            odds.forks++;
+            if (game.teamA.totalRuns > game.teamB.totalRuns) {
+                odds.teamAWins++;
+            } else if (game.teamB.totalRuns > game.teamA.totalRuns) {
+                odds.teamBWins++;
+            } else {
+                odds.draws++;
+            }
+        }
+        return true;
+    }
+};
+
+#endif // CRICKET_MATCH_FORK_H
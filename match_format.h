@@ -0,0 +1,319 @@
+#ifndef CRICKET_MATCH_FORMAT_H
+#define CRICKET_MATCH_FORMAT_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "counter_rng.h"
+#include "game.h"
+#include "parallel_runner.h"
+#include "rng.h"
+#include "simulator.h"
+
+// --- Match Format Policies ---
+
+// A batsman who scores 0 runs off a delivery is OUT (the Game's rule)
+struct ZeroRunsOut {
+    static bool isOut(int runs) {
+        return runs == 0;
+    }
+};
+
+// Runs per delivery are uniform over 0-6 (the Game's distribution)
+struct UniformRuns {
+    static const int maxRuns = 6;
+    static int draw(Rng& rng) {
+        return rng.below(maxRuns + 1);
+    }
+    // Probability that a delivery yields exactly 'runs'
+    static double probability(int runs) {
+        return (runs >= 0 && runs <= maxRuns) ? 1.0 / (maxRuns + 1) : 0.0;
+    }
+};
+
+// --- MatchFormat Definition ---
+// A match format fixed at compile time: balls per innings, players per team,
+// the out rule and the run distribution. Loops over balls and players in a
+// FormatSimulator get constant trip counts the compiler can unroll.
+template <int Balls, int Players, typename OutRule = ZeroRunsOut, typename RunDistribution = UniformRuns>
+struct MatchFormat {
+    static const int balls = Balls;
+    static const int players = Players;
+    typedef OutRule Out;
+    typedef RunDistribution Runs;
+};
+
+typedef MatchFormat<6, 4> OneOverFormat;   // The interactive game: 1 over, 4 players a side
+typedef MatchFormat<120, 11> T20Format;    // 20 overs, 11 players a side
+typedef MatchFormat<300, 11> OdiFormat;    // 50 overs, 11 players a side
+
+// --- FormatSimulator Class Definition ---
+// Headless simulator specialized for one MatchFormat. It plays exactly the
+// same matches as Simulator configured with the same balls and players
+// (same RNG stream, same draws in the same order, same results) but keeps
+// the innings in fixed-size local arrays instead of Game/Team/Player objects.
+// With CounterBased, draws come from the counter-based generator, as in a Game
+// with enableCounterRng(masterSeed), and are generated in bulk a chunk of balls
+// at a time.
+template <typename Format, bool CounterBased = false>
+class FormatSimulator {
+public:
+    static const int balls = Format::balls;
+    static const int players = Format::players;
+    static_assert(!CounterBased || std::is_same<typename Format::Runs, UniformRuns>::value,
+                  "the counter-based generator draws uniform runs");
+
+    uint64_t masterSeed;
+    CounterRng counter;
+    std::vector<Player> pool;       // Player pool for names and ids
+    std::array<int, players> teamAPlayerIds;
+    std::array<int, players> teamBPlayerIds;
+
+    // Constructor: default lineups from the Game's player pool, fixed for every match
+    // (so, unlike Simulator, it never enters the selection phase)
+    explicit FormatSimulator(uint64_t masterSeed = 0) :
+        masterSeed(masterSeed),
+        counter(masterSeed),
+        pool(Game().allPlayers)
+    {
+        std::vector<int> teamA = defaultLineup(0, players, pool.size());
+        std::vector<int> teamB = defaultLineup(1, players, pool.size());
+        for (int i = 0; i < players; ++i) {
+            teamAPlayerIds[i] = teamA[i];
+            teamBPlayerIds[i] = teamB[i];
+        }
+    }
+
+    // Empty results sized for this format and player pool
+    SimulationResults makeResults() const {
+        return SimulationResults(balls, pool);
+    }
+
+    // Plays match number 'matchIndex' on its own RNG stream and records its outcome
+    void playMatch(long long matchIndex, SimulationResults& results) const {
+        Innings first, second;
+        bool teamABatsFirst;
+        if (CounterBased) {
+            CounterRng::Cursor toss = counter.at(matchIndex, 0, 0);
+            teamABatsFirst = drawToss(toss);
+            playInnings<false>(CounterBalls(counter, matchIndex, 1), 0, first);
+            playInnings<true>(CounterBalls(counter, matchIndex, 2), first.runs, second);
+        } else {
+            Rng rng = Rng::forStream(masterSeed, matchIndex);
+            teamABatsFirst = drawToss(rng);
+            auto draw = [&rng](int) { return Format::Runs::draw(rng); };
+            playInnings<false>(draw, 0, first);
+            playInnings<true>(draw, first.runs, second);
+        }
+        recordMatch(teamABatsFirst, first, second, results);
+    }
+
+    // Plays matches [first, last) into 'results'
+    void runRange(long long first, long long last, SimulationResults& results) const {
+        for (long long i = first; i < last; ++i) {
+            playMatch(i, results);
+        }
+    }
+
+    // Plays 'numMatches' matches and returns the aggregate results
+    SimulationResults run(long long numMatches) const {
+        SimulationResults results = makeResults();
+        runRange(0, numMatches, results);
+        return results;
+    }
+
+protected:
+    // One innings: batsman i is the i-th in the batting order, who comes in after i wickets
+    struct Innings {
+        int runs;
+        int wickets;
+        int balls;
+        std::array<int, players> batsmanRuns;
+        std::array<int, players> batsmanBalls;
+    };
+
+    // Draws the toss exactly as Simulator does, from 'rng' (an Rng or a CounterRng::Cursor):
+    // TeamA bats first on (Heads and Bat) or (Tails and Bowl)
+    template <typename Generator>
+    static bool drawToss(Generator& rng) {
+        CRICKET_PROFILE_PHASE(PHASE_TOSS);
+        int tossResult = rng.below(2);
+        int choice = 1 + rng.below(2);
+        return (tossResult == 0) == (choice == 1);
+    }
+
+    // Adds one finished match to 'results'
+    void recordMatch(bool teamABatsFirst, const Innings& first, const Innings& second,
+                     SimulationResults& results) const {
+        const std::array<int, players>& firstIds = teamABatsFirst ? teamAPlayerIds : teamBPlayerIds;
+        const std::array<int, players>& secondIds = teamABatsFirst ? teamBPlayerIds : teamAPlayerIds;
+        int teamARuns = teamABatsFirst ? first.runs : second.runs;
+        int teamBRuns = teamABatsFirst ? second.runs : first.runs;
+
+        results.matches++;
+        results.balls += first.balls + second.balls;
+        results.firstInningsScores[first.runs]++;
+        results.secondInningsScores[second.runs]++;
+        recordPlayers(first, firstIds, secondIds[0], results);
+        recordPlayers(second, secondIds, firstIds[0], results);
+
+        if (teamARuns > teamBRuns) {
+            results.teamAWins++;
+        } else if (teamBRuns > teamARuns) {
+            results.teamBWins++;
+        } else {
+            results.draws++;
+        }
+        if (first.runs > second.runs) {
+            results.battingFirstWins++;
+        } else if (second.runs > first.runs) {
+            results.chasingWins++;
+        }
+    }
+
+private:
+
+    // Runs of each ball of one innings from the counter-based generator, filled
+    // CHUNK balls at a time as the innings reaches them
+    struct CounterBalls {
+        static const int CHUNK = 32;
+        const CounterRng& rng;
+        uint64_t match;
+        int innings;
+        int filled;
+        uint8_t runs[balls];
+
+        CounterBalls(const CounterRng& rng, uint64_t match, int innings) :
+            rng(rng), match(match), innings(innings), filled(0) {}
+
+        int operator()(int ball) {
+            if (ball >= filled) {
+                int count = balls - filled < CHUNK ? balls - filled : CHUNK;
+                rng.fillBelow(Format::Runs::maxRuns + 1, match, innings, filled, count, runs + filled);
+                filled += count;
+            }
+            return runs[ball];
+        }
+    };
+
+    // Plays one innings, drawing ball b's runs with draw(b); a chasing side stops
+    // as soon as it passes 'target'
+    template <bool Chasing, typename Draw>
+    static void playInnings(Draw draw, int target, Innings& innings) {
+        CRICKET_PROFILE_PHASE(PHASE_INNINGS);
+        innings.runs = 0;
+        innings.wickets = 0;
+        innings.balls = 0;
+        innings.batsmanRuns.fill(0);
+        innings.batsmanBalls.fill(0);
+
+        for (int ball = 0; ball < balls; ++ball) {
+            int runs = draw(ball);
+            bool out = Format::Out::isOut(runs);
+            innings.batsmanRuns[innings.wickets] += runs;
+            innings.batsmanBalls[innings.wickets]++;
+            innings.runs += runs;
+            innings.balls++;
+            innings.wickets += out;
+            if (innings.wickets == players || (Chasing && innings.runs > target)) {
+                break;
+            }
+        }
+    }
+
+    // Adds one innings to the season totals; the bowling side's first player bowls every ball
+    static void recordPlayers(const Innings& innings, const std::array<int, players>& battingIds, int bowlerId,
+                              SimulationResults& results) {
+        PlayerStatsStore<long long>& totals = results.playerTotals;
+        for (int i = 0; i < players; ++i) {
+            totals.column(RUNS_SCORED)[battingIds[i]] += innings.batsmanRuns[i];
+            totals.column(BALLS_PLAYED)[battingIds[i]] += innings.batsmanBalls[i];
+            totals.column(DISMISSALS)[battingIds[i]] += (i < innings.wickets);
+        }
+        totals.column(BALLS_BOWLED)[bowlerId] += innings.balls;
+        totals.column(RUNS_GIVEN)[bowlerId] += innings.runs;
+        totals.column(WICKETS_TAKEN)[bowlerId] += innings.wickets;
+    }
+};
+
+// How the Game-based simulators play a ball or an innings
+enum SimulationModel {
+    UNIFORM_MODEL,   // Game's loop, uniform 0-6 (what FormatSimulator reproduces)
+    SKILL_MODEL,     // Game's loop, each ball drawn from the batsman/bowler skill matchup (skill_model.h)
+    REALISTIC_MODEL  // InningsEngine: two batsmen, overs, bowler rotation, extras (innings_engine.h)
+};
+
+// --- GameSimulator Class Definition ---
+// Game-based simulator for one MatchFormat and SimulationModel, constructible
+// from a seed alone so ParallelRunner can run it
+template <typename Format, SimulationModel Model>
+class GameSimulator : public Simulator {
+public:
+    explicit GameSimulator(uint64_t masterSeed = 0) :
+        Simulator(masterSeed)
+    {
+        setFormat(Format::balls, Format::players);
+        if (Model == SKILL_MODEL) {
+            game.enableSkills();
+        }
+        realisticInnings = (Model == REALISTIC_MODEL);
+    }
+};
+
+// --- Runtime Format Dispatch ---
+
+// One entry of the format dispatch table
+struct FormatEntry {
+    const char* name;
+    int balls;
+    int players;
+    SimulationResults (*run)(uint64_t masterSeed, int numThreads, long long numMatches);
+    SimulationResults (*runModel)(uint64_t masterSeed, int numThreads, long long numMatches, SimulationModel model);
+    SimulationResults (*runCounter)(uint64_t masterSeed, int numThreads, long long numMatches); // Counter-based RNG
+};
+
+// Runs 'numMatches' matches of one compile-time format across threads
+template <typename Format, bool CounterBased = false>
+SimulationResults runFormat(uint64_t masterSeed, int numThreads, long long numMatches) {
+    ParallelRunner<FormatSimulator<Format, CounterBased>> runner(masterSeed, numThreads);
+    return runner.run(numMatches);
+}
+
+// Runs 'numMatches' Game-based matches of one format and model across threads
+template <typename Format>
+SimulationResults runFormatModel(uint64_t masterSeed, int numThreads, long long numMatches, SimulationModel model) {
+    if (model == SKILL_MODEL) {
+        return ParallelRunner<GameSimulator<Format, SKILL_MODEL>>(masterSeed, numThreads).run(numMatches);
+    }
+    if (model == REALISTIC_MODEL) {
+        return ParallelRunner<GameSimulator<Format, REALISTIC_MODEL>>(masterSeed, numThreads).run(numMatches);
+    }
+    return ParallelRunner<GameSimulator<Format, UNIFORM_MODEL>>(masterSeed, numThreads).run(numMatches);
+}
+
+// Table of the specialized formats that can be picked at runtime by name
+inline const std::vector<FormatEntry>& formatTable() {
+    static const std::vector<FormatEntry> table = {
+        {"one-over", OneOverFormat::balls, OneOverFormat::players, &runFormat<OneOverFormat>,
+         &runFormatModel<OneOverFormat>, &runFormat<OneOverFormat, true>},
+        {"t20", T20Format::balls, T20Format::players, &runFormat<T20Format>, &runFormatModel<T20Format>,
+         &runFormat<T20Format, true>},
+        {"odi", OdiFormat::balls, OdiFormat::players, &runFormat<OdiFormat>, &runFormatModel<OdiFormat>,
+         &runFormat<OdiFormat, true>},
+    };
+    return table;
+}
+
+// Looks up a format by name; returns nullptr if there is no such format
+inline const FormatEntry* findFormat(const std::string& name) {
+    for (const auto& entry : formatTable()) {
+        if (name == entry.name) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+#endif // CRICKET_MATCH_FORMAT_H
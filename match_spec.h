@@ -0,0 +1,252 @@
+#ifndef CRICKET_MATCH_SPEC_H
+#define CRICKET_MATCH_SPEC_H
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "game.h"
+#include "match_format.h"
+#include "simulator.h"
+
+// --- MatchSpec Definition ---
+// Everything needed to play one match without prompts, written as one line of
+// key=value fields in any order, for example:
+//   format=one-over teamA=1,2,3,4 teamB=5,6,7,8 call=1 choice=bat seed=42 match=0
+// Fields left out keep their defaults: the format's default line-ups, call 1,
+// a random bat/bowl choice, seed 0 and the spec's position in its batch.
+// The match draws from RNG stream 'match' of 'seed', like Simulator match
+// 'match' of that seed, so a spec with only a seed replays a headless match.
+struct MatchSpec {
+    const FormatEntry* format;
+    std::vector<int> teamAPlayerIds; // Batting order; empty = the format's default line-up
+    std::vector<int> teamBPlayerIds;
+    int call;                        // Toss call: 1 (TeamA) or 2 (TeamB), anything else random
+    int choice;                      // Toss winner's choice: 1 = Bat, 2 = Bowl, 0 = random
+    uint64_t seed;
+    long long matchIndex;            // RNG stream; -1 = position in the batch
+
+    MatchSpec() {
+        clear();
+    }
+
+    // Back to the defaults (keeping the line-up buffers)
+    void clear() {
+        format = findFormat("one-over");
+        teamAPlayerIds.clear();
+        teamBPlayerIds.clear();
+        call = 1;
+        choice = 0;
+        seed = 0;
+        matchIndex = -1;
+    }
+
+    // Reads the fields of one spec from [begin, end) in a single pass; words
+    // without '=' (such as command line flags) are skipped. Returns false with
+    // a message in 'error' on an unknown key or a malformed value.
+    bool parse(const char* begin, const char* end, std::string& error) {
+        const char* p = begin;
+        while (p < end) {
+            while (p < end && isSpace(*p)) {
+                p++;
+            }
+            const char* word = p;
+            const char* equals = nullptr;
+            while (p < end && !isSpace(*p)) {
+                if (*p == '=' && equals == nullptr) {
+                    equals = p;
+                }
+                p++;
+            }
+            if (word == p || equals == nullptr) {
+                continue;
+            }
+            if (!setField(std::string(word, equals), equals + 1, p, error)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool parse(const std::string& text, std::string& error) {
+        return parse(text.data(), text.data() + text.size(), error);
+    }
+
+    // Fills in default line-ups and checks both teams against a pool of 'poolSize'
+    // players: right size, known ids, nobody twice. When the pool is too small for
+    // two separate sides (as in 11-a-side formats), both teams may share players.
+    bool validate(int poolSize, std::string& error) {
+        if (teamAPlayerIds.empty()) {
+            teamAPlayerIds = defaultLineup(0, format->players, poolSize);
+        }
+        if (teamBPlayerIds.empty()) {
+            teamBPlayerIds = defaultLineup(1, format->players, poolSize);
+        }
+        bool separateSides = 2 * format->players <= poolSize;
+        PlayerSet teamA;
+        PlayerSet teamB;
+        if (!checkLineup("teamA", teamAPlayerIds, poolSize, teamA, error) ||
+            !checkLineup("teamB", teamBPlayerIds, poolSize, teamB, error)) {
+            return false;
+        }
+        if (separateSides && (teamA & teamB).any()) {
+            error = "a player is picked for both teams";
+            return false;
+        }
+        return true;
+    }
+
+    // Sets 'game' up for this (validated) spec with no I/O: format, line-ups, RNG stream and toss
+    void setUp(Game& game, long long positionInBatch) const {
+        game.maxDeliveries = format->balls;
+        game.playersPerTeam = format->players;
+        game.fieldTeams(teamAPlayerIds, teamBPlayerIds);
+        game.rng = Rng::forStream(seed, matchIndex >= 0 ? matchIndex : positionInBatch);
+        game.decideToss(call, choice);
+    }
+
+private:
+    static bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    // Parses a non-negative decimal integer filling all of [begin, end)
+    static bool parseNumber(const char* begin, const char* end, uint64_t& value) {
+        if (begin == end) {
+            return false;
+        }
+        value = 0;
+        for (const char* p = begin; p < end; ++p) {
+            if (*p < '0' || *p > '9') {
+                return false;
+            }
+            value = value * 10 + (*p - '0');
+        }
+        return true;
+    }
+
+    // Parses a comma-separated list of player ids
+    static bool parseLineup(const char* begin, const char* end, std::vector<int>& ids) {
+        ids.clear();
+        const char* p = begin;
+        while (p <= end) {
+            const char* comma = p;
+            while (comma < end && *comma != ',') {
+                comma++;
+            }
+            uint64_t id;
+            if (!parseNumber(p, comma, id) || id > 255) {
+                return false;
+            }
+            ids.push_back(static_cast<int>(id));
+            p = comma + 1;
+        }
+        return true;
+    }
+
+    bool setField(const std::string& key, const char* begin, const char* end, std::string& error) {
+        uint64_t number = 0;
+        bool ok = true;
+        if (key == "format") {
+            format = findFormat(std::string(begin, end));
+            ok = format != nullptr;
+        } else if (key == "teamA") {
+            ok = parseLineup(begin, end, teamAPlayerIds);
+        } else if (key == "teamB") {
+            ok = parseLineup(begin, end, teamBPlayerIds);
+        } else if (key == "call") {
+            ok = parseNumber(begin, end, number) || std::string(begin, end) == "random";
+            call = (number == 1 || number == 2) ? static_cast<int>(number) : 0;
+        } else if (key == "choice") {
+            std::string value(begin, end);
+            choice = value == "bat" || value == "1" ? 1 : value == "bowl" || value == "2" ? 2 : 0;
+            ok = choice != 0 || value == "random";
+        } else if (key == "seed") {
+            ok = parseNumber(begin, end, seed);
+        } else if (key == "match") {
+            ok = parseNumber(begin, end, number);
+            matchIndex = static_cast<long long>(number);
+        } else {
+            error = "unknown field '" + key + "'";
+            return false;
+        }
+        if (!ok) {
+            error = "bad value for '" + key + "': '" + std::string(begin, end) + "'";
+        }
+        return ok;
+    }
+
+    // Checks one line-up and collects its ids in 'picked'
+    bool checkLineup(const char* team, const std::vector<int>& ids, int poolSize, PlayerSet& picked,
+                     std::string& error) const {
+        if (static_cast<int>(ids.size()) != format->players) {
+            error = std::string(team) + " needs " + std::to_string(format->players) + " players";
+            return false;
+        }
+        for (int id : ids) {
+            if (id < 1 || id > poolSize) {
+                error = std::string(team) + ": no player with id " + std::to_string(id);
+                return false;
+            }
+            if (picked.test(id)) {
+                error = std::string(team) + ": player " + std::to_string(id) + " is picked twice";
+                return false;
+            }
+            picked.set(id);
+        }
+        return true;
+    }
+};
+
+// --- Batch Runner ---
+
+// Plays every spec in 'in' (one per line; blank lines and lines starting with
+// '#' are skipped) at full speed with no prompts, writing one result line per
+// match to 'out' and problems to 'err'. Returns the number of invalid specs.
+inline long long playSpecBatch(std::istream& in, std::ostream& out, std::ostream& err) {
+    Game game;
+    game.clock = Clock::instant();
+    MatchSpec spec;
+    std::string line;
+    std::string error;
+    long long position = 0;
+    long long played = 0;
+    long long invalid = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    out << "Match\tFormat\tTeamA\tTeamB\tBatting first\tResult\n";
+    for (long long lineNumber = 1; std::getline(in, line); ++lineNumber) {
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') {
+            continue;
+        }
+        spec.clear();
+        if (!spec.parse(line, error) || !spec.validate(static_cast<int>(game.allPlayers.size()), error)) {
+            err << "Line " << lineNumber << ": " << error << "\n";
+            invalid++;
+            position++;
+            continue;
+        }
+
+        long long matchIndex = spec.matchIndex >= 0 ? spec.matchIndex : position;
+        spec.setUp(game, position);
+        Team* firstBatting = game.battingTeam;
+        game.simulateInnings(1);
+        game.simulateInnings(2);
+        const Team& a = game.teamA;
+        const Team& b = game.teamB;
+        out << matchIndex << "\t" << spec.format->name << "\t" << a.totalRuns << "/" << a.totalWicketsLost << "\t"
+            << b.totalRuns << "/" << b.totalWicketsLost << "\t" << firstBatting->name << "\t"
+            << (a.totalRuns > b.totalRuns ? "TeamA" : b.totalRuns > a.totalRuns ? "TeamB" : "Draw") << "\n";
+        played++;
+        position++;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    err << "Played " << played << " matches (" << invalid << " invalid specs) in " << seconds << " s ("
+        << played / (seconds > 0 ? seconds : 1.0) << " matches/s)\n";
+    return invalid;
+}
+
+#endif // CRICKET_MATCH_SPEC_H
@@ -0,0 +1,104 @@
+#ifndef CRICKET_MATCH_STATE_H
+#define CRICKET_MATCH_STATE_H
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "team.h"
+
+// Most players a side can field in a MatchState
+const int MAX_LINEUP = 16;
+
+// Index stored for "no team" / "no player"
+const uint8_t NO_INDEX = 0xFF;
+
+// --- MatchState Definition ---
+// Everything needed to carry on a match from any ball, with no pointers: the
+// sides are indices (0 = TeamA, 1 = TeamB), the striker and bowler are
+// indices into their line-ups and players are stored by Player::id, so a
+// state taken from one Game can be restored into any Game with the same pool.
+// It is a fixed-size plain struct: saving, copying and restoring are memcpy,
+// and the bytes themselves are the binary blob (host byte order).
+// Names and skill profiles come from the pool on restore, so they are not stored.
+struct MatchState {
+    struct PlayerState {
+        uint8_t id;
+        uint8_t flags;          // Bit 0: isOut; bits 1-3: DismissalKind
+        uint8_t wicketsTaken;
+        uint8_t reserved;
+        uint16_t runsScored;
+        uint16_t ballsPlayed;
+        uint16_t ballsBowled;
+        uint16_t runsGiven;
+    };
+
+    struct TeamState {
+        uint16_t totalRuns;
+        uint16_t totalBallsBowled;
+        uint16_t extras;
+        uint8_t totalWicketsLost;
+        uint8_t numPlayers;
+        PlayerState players[MAX_LINEUP];
+    };
+
+    char magic[4];              // "CRST"
+    uint8_t version;
+    uint8_t inningsNum;         // 0 before the first ball, then 1 or 2
+    uint8_t battingTeam;        // 0 = TeamA, 1 = TeamB, NO_INDEX before the toss
+    uint8_t batsmanIndex;       // Striker's place in the batting order (the order's size once all are out)
+    uint8_t bowlerIndex;        // Bowler's place in the bowling side, NO_INDEX if none
+    uint8_t playersPerTeam;
+    uint16_t maxDeliveries;
+    uint16_t currentBall;       // Balls bowled so far in the current innings
+    uint16_t reserved;
+    uint64_t rngState;
+    TeamState teams[2];
+
+    static const uint8_t VERSION = 1;
+
+    // Clears the state (so unused slots are zero in the blob) and stamps the header
+    void begin() {
+        std::memset(this, 0, sizeof(MatchState));
+        std::memcpy(magic, "CRST", 4);
+        version = VERSION;
+    }
+
+    bool isValid() const {
+        return std::memcmp(magic, "CRST", 4) == 0 && version == VERSION;
+    }
+
+    // Reads a state from a blob written from a MatchState; false if it is not one
+    bool fromBytes(const void* bytes, size_t size) {
+        if (size != sizeof(MatchState)) {
+            return false;
+        }
+        std::memcpy(this, bytes, sizeof(MatchState));
+        return isValid();
+    }
+
+    static void savePlayer(const Player& player, PlayerState& state) {
+        state.id = static_cast<uint8_t>(player.id);
+        state.flags = static_cast<uint8_t>((player.isOut ? 1 : 0) | (player.dismissal << 1));
+        state.wicketsTaken = static_cast<uint8_t>(player.wicketsTaken);
+        state.reserved = 0;
+        state.runsScored = static_cast<uint16_t>(player.runsScored);
+        state.ballsPlayed = static_cast<uint16_t>(player.ballsPlayed);
+        state.ballsBowled = static_cast<uint16_t>(player.ballsBowled);
+        state.runsGiven = static_cast<uint16_t>(player.runsGiven);
+    }
+
+    // Copies the counters of 'state' onto 'player' (already taken from the pool)
+    static void restorePlayer(const PlayerState& state, Player& player) {
+        player.isOut = (state.flags & 1) != 0;
+        player.dismissal = static_cast<DismissalKind>((state.flags >> 1) & 7);
+        player.wicketsTaken = state.wicketsTaken;
+        player.runsScored = state.runsScored;
+        player.ballsPlayed = state.ballsPlayed;
+        player.ballsBowled = state.ballsBowled;
+        player.runsGiven = state.runsGiven;
+    }
+};
+
+static_assert(std::is_trivially_copyable<MatchState>::value, "MatchState must stay a plain blob");
+
+#endif // CRICKET_MATCH_STATE_H
@@ -0,0 +1,80 @@
+#ifndef CRICKET_PARALLEL_RUNNER_H
+#define CRICKET_PARALLEL_RUNNER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+#include "aligned_allocator.h"
+#include "simulator.h"
+
+// --- ParallelRunner Class Definition ---
+// Spreads independent headless matches across threads. Match i always plays
+// on RNG stream i of the master seed, and results are integer counts merged
+// after the workers finish, so the output is bit-identical for any thread count.
+// 'MatchSimulator' is Simulator or any type with the same constructor,
+// makeResults() and runRange() (e.g. a FormatSimulator).
+template <typename MatchSimulator = Simulator>
+class ParallelRunner {
+public:
+    uint64_t masterSeed;
+    int numThreads;
+    long long blockSize; // Matches claimed by a worker at a time
+
+    // Constructor: 0 threads means one per hardware core
+    ParallelRunner(uint64_t masterSeed, int numThreads = 0) :
+        masterSeed(masterSeed),
+        numThreads(numThreads > 0 ? numThreads : static_cast<int>(std::thread::hardware_concurrency())),
+        blockSize(4096)
+    {
+        if (this->numThreads < 1) {
+            this->numThreads = 1;
+        }
+    }
+
+    // Plays 'numMatches' matches across all workers and returns the merged results
+    SimulationResults run(long long numMatches) {
+        // Each worker owns its Simulator and results; the only shared write is the block counter
+        struct alignas(64) Worker {
+            MatchSimulator simulator;
+            SimulationResults results;
+            Worker(uint64_t seed) : simulator(seed), results(simulator.makeResults()) {}
+        };
+
+        std::vector<Worker, AlignedAllocator<Worker>> workers; // One cache line or more each
+        workers.reserve(numThreads);
+        for (int t = 0; t < numThreads; ++t) {
+            workers.emplace_back(masterSeed);
+        }
+
+        std::atomic<long long> nextBlock(0);
+        long long numBlocks = (numMatches + blockSize - 1) / blockSize;
+        auto work = [&](Worker& worker) {
+            long long block;
+            while ((block = nextBlock.fetch_add(1, std::memory_order_relaxed)) < numBlocks) {
+                long long first = block * blockSize;
+                long long last = std::min(first + blockSize, numMatches);
+                worker.simulator.runRange(first, last, worker.results);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (int t = 1; t < numThreads; ++t) {
+            threads.emplace_back(work, std::ref(workers[t]));
+        }
+        work(workers[0]); // The calling thread works too
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        SimulationResults results = workers[0].simulator.makeResults();
+        for (const auto& worker : workers) {
+            results.merge(worker.results);
+        }
+        return results;
+    }
+};
+
+#endif // CRICKET_PARALLEL_RUNNER_H
@@ -0,0 +1,149 @@
+#ifndef CRICKET_PLAYER_STATS_H
+#define CRICKET_PLAYER_STATS_H
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "game.h"
+
+// Counter columns held by a PlayerStatsStore
+enum PlayerStat {
+    RUNS_SCORED,
+    BALLS_PLAYED,
+    BALLS_BOWLED,
+    RUNS_GIVEN,
+    WICKETS_TAKEN,
+    DISMISSALS,
+    NUM_PLAYER_STATS
+};
+
+// --- PlayerStatsStore Class Definition ---
+// Columnar (structure-of-arrays) player stats keyed by Player::id. All
+// counters live in one contiguous buffer, one column per PlayerStat, and
+// names are interned separately. Resets, season totals and rate
+// calculations are then straight loops over that buffer which the compiler
+// can vectorize. 'Count' is int for one match and long long for season totals.
+template <typename Count>
+class PlayerStatsStore {
+public:
+    std::vector<std::string> names; // Interned names: names[id]
+
+    // Constructor: one row per id in [0, numIds); id 0 is unused by the player pool
+    explicit PlayerStatsStore(int numIds = 0) :
+        names(numIds),
+        counts(static_cast<size_t>(numIds) * NUM_PLAYER_STATS, 0),
+        rows(numIds) {}
+
+    // Builds a store with one row per player in the pool, keyed by Player::id
+    static PlayerStatsStore fromPool(const std::vector<Player>& pool) {
+        int maxId = 0;
+        for (const auto& player : pool) {
+            maxId = std::max(maxId, player.id);
+        }
+        PlayerStatsStore store(maxId + 1);
+        for (const auto& player : pool) {
+            store.names[player.id] = player.name;
+        }
+        return store;
+    }
+
+    // Number of rows (ids) in the store
+    int size() const {
+        return static_cast<int>(rows);
+    }
+
+    // Contiguous column for one stat, indexed by player id
+    Count* column(PlayerStat stat) {
+        return counts.data() + stat * rows;
+    }
+    const Count* column(PlayerStat stat) const {
+        return counts.data() + stat * rows;
+    }
+
+    // Zeroes every counter (per-match reset)
+    void reset() {
+        std::fill(counts.begin(), counts.end(), 0);
+    }
+
+    // Records one delivery between a batsman and a bowler
+    void recordDelivery(int batsmanId, int bowlerId, int runs, bool wicket) {
+        Count* batsman = counts.data() + batsmanId;
+        Count* bowler = counts.data() + bowlerId;
+        size_t stride = rows;
+        batsman[RUNS_SCORED * stride] += runs;
+        batsman[BALLS_PLAYED * stride] += 1;
+        batsman[DISMISSALS * stride] += wicket;
+        bowler[BALLS_BOWLED * stride] += 1;
+        bowler[RUNS_GIVEN * stride] += runs;
+        bowler[WICKETS_TAKEN * stride] += wicket;
+    }
+
+    // Adds one player's match counters (from the Game's Player records) into their row
+    void addPlayerMatch(const Player& player) {
+        column(RUNS_SCORED)[player.id] += player.runsScored;
+        column(BALLS_PLAYED)[player.id] += player.ballsPlayed;
+        column(BALLS_BOWLED)[player.id] += player.ballsBowled;
+        column(RUNS_GIVEN)[player.id] += player.runsGiven;
+        column(WICKETS_TAKEN)[player.id] += player.wicketsTaken;
+        column(DISMISSALS)[player.id] += player.isOut;
+    }
+
+    // Adds every counter of another store with the same rows into this one
+    template <typename OtherCount>
+    void accumulate(const PlayerStatsStore<OtherCount>& other) {
+        Count* dst = counts.data();
+        const OtherCount* src = other.data();
+        size_t n = std::min(counts.size(), static_cast<size_t>(other.size()) * NUM_PLAYER_STATS);
+        for (size_t i = 0; i < n; ++i) {
+            dst[i] += src[i];
+        }
+    }
+
+    // Adds another store with the same rows (e.g. a worker's partial totals)
+    void merge(const PlayerStatsStore& other) {
+        accumulate(other);
+    }
+
+    // Fills 'out' with runs per 100 balls faced for every id (0 if no balls faced)
+    void strikeRates(std::vector<double>& out) const {
+        ratio(column(RUNS_SCORED), column(BALLS_PLAYED), 100.0, out);
+    }
+
+    // Fills 'out' with runs conceded per 6 balls bowled for every id (0 if no balls bowled)
+    void economyRates(std::vector<double>& out) const {
+        ratio(column(RUNS_GIVEN), column(BALLS_BOWLED), 6.0, out);
+    }
+
+    // Sum of one column over all ids
+    long long total(PlayerStat stat) const {
+        const Count* values = column(stat);
+        long long sum = 0;
+        for (size_t i = 0; i < rows; ++i) {
+            sum += values[i];
+        }
+        return sum;
+    }
+
+    // Raw counter buffer: NUM_PLAYER_STATS columns of size() rows, back to back
+    const Count* data() const {
+        return counts.data();
+    }
+
+private:
+    std::vector<Count> counts;
+    size_t rows;
+
+    // out[i] = scale * numerator[i] / denominator[i], or 0 where the denominator is 0.
+    // Written branch-free so the loop vectorizes.
+    void ratio(const Count* numerator, const Count* denominator, double scale, std::vector<double>& out) const {
+        out.resize(rows);
+        double* dst = out.data();
+        for (size_t i = 0; i < rows; ++i) {
+            double d = static_cast<double>(denominator[i]);
+            double safe = d > 0 ? d : 1.0;
+            dst[i] = d > 0 ? scale * static_cast<double>(numerator[i]) / safe : 0.0;
+        }
+    }
+};
+
+#endif // CRICKET_PLAYER_STATS_H
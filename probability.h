@@ -0,0 +1,186 @@
+#ifndef CRICKET_PROBABILITY_H
+#define CRICKET_PROBABILITY_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "match_format.h"
+
+// Exact outcome probabilities of a whole match
+struct MatchOdds {
+    double battingFirstWins;
+    double chasingWins;
+    double draw;
+};
+
+// --- ExactInnings Class Definition ---
+// Exact innings probabilities for one MatchFormat, by dynamic programming over
+// the playInnings() state space (balls left, wickets left, runs). For every
+// (balls left, wickets left) state the table holds the distribution of the
+// runs still to come and its tail sums, so the first-innings score
+// distribution and the chase-win probability for any target are lookups.
+template <typename Format>
+class ExactInnings {
+public:
+    static const int balls = Format::balls;
+    static const int players = Format::players;
+    static const int maxRuns = Format::Runs::maxRuns;
+
+    // Builds the tables (one pass, smallest states first)
+    ExactInnings() {
+        // Row offsets: state (b, w) holds b * maxRuns + 1 probabilities
+        offsets.resize((balls + 1) * (players + 1) + 1);
+        size_t offset = 0;
+        for (int b = 0; b <= balls; ++b) {
+            for (int w = 0; w <= players; ++w) {
+                offsets[index(b, w)] = offset;
+                offset += rowLength(b);
+            }
+        }
+        offsets.back() = offset;
+        remaining.assign(offset, 0.0);
+        atLeast.assign(offset, 0.0);
+
+        for (int b = 0; b <= balls; ++b) {
+            for (int w = 0; w <= players; ++w) {
+                double* row = &remaining[offsets[index(b, w)]];
+                if (b == 0 || w == 0) {
+                    row[0] = 1.0; // Innings over: no more runs
+                } else {
+                    for (int runs = 0; runs <= maxRuns; ++runs) {
+                        double p = Format::Runs::probability(runs);
+                        int nextWickets = Format::Out::isOut(runs) ? w - 1 : w;
+                        const double* next = &remaining[offsets[index(b - 1, nextWickets)]];
+                        int nextLength = rowLength(b - 1);
+                        for (int k = 0; k < nextLength; ++k) {
+                            row[k + runs] += p * next[k];
+                        }
+                    }
+                }
+
+                // Tail sums: atLeast[k] = P(at least k more runs)
+                double* tail = &atLeast[offsets[index(b, w)]];
+                double sum = 0.0;
+                for (int k = rowLength(b) - 1; k >= 0; --k) {
+                    sum += row[k];
+                    tail[k] = sum;
+                }
+            }
+        }
+    }
+
+    // Highest score one innings can reach
+    static int maxScore() {
+        return balls * maxRuns;
+    }
+
+    // P(exactly 'runs' more runs) from a state with 'ballsLeft' balls and 'wicketsLeft' wickets in hand
+    double probabilityOfRuns(int ballsLeft, int wicketsLeft, int runs) const {
+        if (runs < 0 || runs >= rowLength(ballsLeft)) {
+            return 0.0;
+        }
+        return remaining[offsets[index(ballsLeft, wicketsLeft)] + runs];
+    }
+
+    // P(at least 'runs' more runs) from a state; a side chasing 'runs' wins with exactly this probability
+    double probabilityOfAtLeast(int ballsLeft, int wicketsLeft, int runs) const {
+        if (runs <= 0) {
+            return 1.0;
+        }
+        if (runs >= rowLength(ballsLeft)) {
+            return 0.0;
+        }
+        return atLeast[offsets[index(ballsLeft, wicketsLeft)] + runs];
+    }
+
+    // Full first-innings score distribution: element r is P(score == r)
+    std::vector<double> firstInningsDistribution() const {
+        const double* row = &remaining[offsets[index(balls, players)]];
+        return std::vector<double>(row, row + rowLength(balls));
+    }
+
+    // P(the chasing side wins) when it needs 'target' runs from the start of innings 2
+    double chaseWinProbability(int target) const {
+        return probabilityOfAtLeast(balls, players, target);
+    }
+
+    // P(the chasing side wins) mid-innings: 'runsNeeded' more runs from the given state
+    double chaseWinProbability(int ballsLeft, int wicketsLeft, int runsNeeded) const {
+        return probabilityOfAtLeast(ballsLeft, wicketsLeft, runsNeeded);
+    }
+
+    // Exact match outcome probabilities, combining both innings. Stopping a
+    // successful chase early never changes the result, so the chasing side
+    // wins exactly when its unstopped score would pass the first innings.
+    MatchOdds matchOdds() const {
+        MatchOdds odds = {0.0, 0.0, 0.0};
+        const double* first = &remaining[offsets[index(balls, players)]];
+        for (int score = 0; score < rowLength(balls); ++score) {
+            double win = chaseWinProbability(score + 1);
+            double tie = probabilityOfRuns(balls, players, score);
+            odds.chasingWins += first[score] * win;
+            odds.draw += first[score] * tie;
+            odds.battingFirstWins += first[score] * (1.0 - win - tie);
+        }
+        return odds;
+    }
+
+private:
+    std::vector<size_t> offsets;  // Start of each (balls left, wickets left) row
+    std::vector<double> remaining; // P(exactly k more runs)
+    std::vector<double> atLeast;   // P(at least k more runs)
+
+    static int index(int ballsLeft, int wicketsLeft) {
+        return ballsLeft * (players + 1) + wicketsLeft;
+    }
+
+    static int rowLength(int ballsLeft) {
+        return ballsLeft * maxRuns + 1;
+    }
+};
+
+// Shared, lazily built tables for one format (built once on first use)
+template <typename Format>
+const ExactInnings<Format>& exactInnings() {
+    static const ExactInnings<Format> tables;
+    return tables;
+}
+
+// Prints the exact match odds and first-innings score distribution of one format
+template <typename Format>
+void printExactOdds(std::ostream& out) {
+    const ExactInnings<Format>& exact = exactInnings<Format>();
+    MatchOdds odds = exact.matchOdds();
+    out << "Batting first win probability: " << odds.battingFirstWins << "\n";
+    out << "Chasing win probability: " << odds.chasingWins << "\n";
+    out << "Draw probability: " << odds.draw << "\n";
+    out << "Runs\tInnings 1\tChase win if target\n";
+    std::vector<double> distribution = exact.firstInningsDistribution();
+    for (int runs = 0; runs < static_cast<int>(distribution.size()); ++runs) {
+        if (distribution[runs] > 0.0) {
+            out << runs << "\t" << distribution[runs] << "\t" << exact.chaseWinProbability(runs) << "\n";
+        }
+    }
+}
+
+// Runtime lookup of printExactOdds by format name (see formatTable()); returns false for unknown formats
+inline bool printExactOdds(const std::string& formatName, std::ostream& out) {
+    static const struct {
+        const char* name;
+        void (*print)(std::ostream&);
+    } table[] = {
+        {"one-over", &printExactOdds<OneOverFormat>},
+        {"t20", &printExactOdds<T20Format>},
+        {"odi", &printExactOdds<OdiFormat>},
+    };
+    for (const auto& entry : table) {
+        if (formatName == entry.name) {
+            entry.print(out);
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif // CRICKET_PROBABILITY_H
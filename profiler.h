@@ -0,0 +1,192 @@
+#ifndef CRICKET_PROFILER_H
+#define CRICKET_PROFILER_H
+
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h> // For __rdtsc()
+#else
+#include <chrono>
+#endif
+
+// --- Phase Profiler ---
+// Opt-in cycle counters for the phases of a match. Build with
+// -DCRICKET_PROFILE (the CMake option of the same name) and every
+// CRICKET_PROFILE_PHASE(PHASE) scope adds its cycles and one call to its
+// phase; without it the macro expands to nothing and nothing is compiled in.
+// Each thread counts into its own counters (no atomics on the hot path),
+// which are folded into the totals when the thread exits. Selection is only
+// counted where a Game fields its teams: the specialized and lockstep
+// simulators fix their line-ups once and report no selection calls.
+
+enum ProfilePhase {
+    PHASE_TOSS,
+    PHASE_SELECTION,
+    PHASE_INNINGS,
+    PHASE_RENDER,
+    NUM_PROFILE_PHASES
+};
+
+inline const char* phaseName(int phase) {
+    static const char* const names[NUM_PROFILE_PHASES] = {"toss", "selection", "innings", "render"};
+    return names[phase];
+}
+
+// Cycles and calls per phase
+struct PhaseCounters {
+    uint64_t cycles[NUM_PROFILE_PHASES] = {};
+    uint64_t calls[NUM_PROFILE_PHASES] = {};
+
+    void accumulate(const PhaseCounters& other) {
+        for (int phase = 0; phase < NUM_PROFILE_PHASES; ++phase) {
+            cycles[phase] += other.cycles[phase];
+            calls[phase] += other.calls[phase];
+        }
+    }
+
+    // {"toss": {"calls": N, "cycles": C, "cycles_per_call": X}, ...}
+    void writeJson(std::ostream& out) const {
+        out << "{";
+        for (int phase = 0; phase < NUM_PROFILE_PHASES; ++phase) {
+            out << (phase > 0 ? ", " : "") << "\"" << phaseName(phase) << "\": {\"calls\": " << calls[phase]
+                << ", \"cycles\": " << cycles[phase] << ", \"cycles_per_call\": "
+                << (calls[phase] > 0 ? static_cast<double>(cycles[phase]) / calls[phase] : 0.0) << "}";
+        }
+        out << "}";
+    }
+};
+
+// --- Profiler Class Definition ---
+class Profiler {
+public:
+    // Time stamp counter (nanoseconds on machines without one)
+    static uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    // Name of the unit now() counts in
+    static const char* unit() {
+#if defined(__x86_64__) || defined(__i386__)
+        return "tsc_cycles";
+#else
+        return "ns";
+#endif
+    }
+
+    // True if this build counts phases
+    static bool enabled() {
+#ifdef CRICKET_PROFILE
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // This thread's counters
+    static PhaseCounters& local() {
+        thread_local ThreadCounters counters;
+        return counters.counters;
+    }
+
+    // Counters of every thread that has finished plus the calling thread's; read it
+    // once the workers have been joined
+    static PhaseCounters totals() {
+        Profiler& profiler = instance();
+        std::lock_guard<std::mutex> lock(profiler.mutex);
+        PhaseCounters sum = profiler.retired;
+        for (const PhaseCounters* live : profiler.live) {
+            sum.accumulate(*live);
+        }
+        return sum;
+    }
+
+    // {"enabled": true, "unit": "tsc_cycles", "phases": {...}} for the current totals
+    static void writeJson(std::ostream& out) {
+        out << "{\"enabled\": " << (enabled() ? "true" : "false") << ", \"unit\": \"" << unit()
+            << "\", \"phases\": ";
+        totals().writeJson(out);
+        out << "}";
+    }
+
+    // Zeroes the totals and the calling thread's counters
+    static void reset() {
+        Profiler& profiler = instance();
+        std::lock_guard<std::mutex> lock(profiler.mutex);
+        profiler.retired = PhaseCounters();
+        local() = PhaseCounters();
+    }
+
+private:
+    std::mutex mutex;
+    PhaseCounters retired;              // Folded in from threads that have exited
+    std::vector<PhaseCounters*> live;   // Counters of running threads
+
+    static Profiler& instance() {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    // One thread's counters, registered while the thread runs
+    struct ThreadCounters {
+        PhaseCounters counters;
+
+        ThreadCounters() {
+            Profiler& profiler = instance();
+            std::lock_guard<std::mutex> lock(profiler.mutex);
+            profiler.live.push_back(&counters);
+        }
+
+        ~ThreadCounters() {
+            Profiler& profiler = instance();
+            std::lock_guard<std::mutex> lock(profiler.mutex);
+            profiler.retired.accumulate(counters);
+            for (size_t i = 0; i < profiler.live.size(); ++i) {
+                if (profiler.live[i] == &counters) {
+                    profiler.live[i] = profiler.live.back();
+                    profiler.live.pop_back();
+                    break;
+                }
+            }
+        }
+    };
+};
+
+// --- PhaseTimer Class Definition ---
+// Adds the cycles of its scope to one phase of this thread's counters
+class PhaseTimer {
+public:
+    explicit PhaseTimer(ProfilePhase phase) :
+        counters(Profiler::local()),
+        phase(phase),
+        start(Profiler::now()) {}
+
+    ~PhaseTimer() {
+        counters.cycles[phase] += Profiler::now() - start;
+        counters.calls[phase]++;
+    }
+
+private:
+    PhaseCounters& counters;
+    ProfilePhase phase;
+    uint64_t start;
+
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+};
+
+#define CRICKET_PROFILE_CONCAT_INNER(a, b) a##b
+#define CRICKET_PROFILE_CONCAT(a, b) CRICKET_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef CRICKET_PROFILE
+#define CRICKET_PROFILE_PHASE(phase) PhaseTimer CRICKET_PROFILE_CONCAT(phaseTimer, __LINE__)(phase)
+#else
+#define CRICKET_PROFILE_PHASE(phase) ((void)0)
+#endif
+
+#endif // CRICKET_PROFILER_H
@@ -0,0 +1,112 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "event_log.h"
+#include "game.h"
+#include "match_archive.h"
+#include "query.h"
+
+// --- Query Helpers ---
+
+// Player::id for a name (any case) or a numeric id; 0 if no player matches
+int findPlayerId(const std::vector<Player>& pool, const std::string& nameOrId) {
+    for (const auto& player : pool) {
+        std::string name = player.name;
+        bool same = name.size() == nameOrId.size();
+        for (size_t i = 0; same && i < name.size(); ++i) {
+            same = tolower(name[i]) == tolower(nameOrId[i]);
+        }
+        if (same || std::to_string(player.id) == nameOrId) {
+            return player.id;
+        }
+    }
+    return 0;
+}
+
+void printUsage(const char* program) {
+    std::cerr << "Usage:\n"
+              << "  " << program << " build LOG ARCHIVE          Convert an event log to a columnar archive\n"
+              << "  " << program << " ARCHIVE runs PLAYER        Runs scored, per ball and per match\n"
+              << "  " << program << " ARCHIVE conceded PLAYER    Runs conceded, per ball and per match\n"
+              << "  " << program << " ARCHIVE opens PLAYER       Results when PLAYER opens the batting\n"
+              << "  " << program << " ARCHIVE players            Totals for every player\n"
+              << "Add --threads T to use T threads (default: all cores).\n";
+}
+
+// --- Main Function ---
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // Archive builder: ./cricket_query build LOG ARCHIVE
+    if (std::string(argv[1]) == "build") {
+        EventLogReader log;
+        if (argc < 4 || !log.open(argv[2])) {
+            std::cerr << "Cannot read event log '" << (argc > 2 ? argv[2] : "") << "'.\n";
+            return 1;
+        }
+        if (!MatchArchive::build(log, argv[3])) {
+            std::cerr << "Cannot write archive '" << argv[3] << "'.\n";
+            return 1;
+        }
+        std::cout << "Archived " << log.numRecords << " deliveries.\n";
+        return 0;
+    }
+
+    MatchArchive archive;
+    if (!archive.open(argv[1])) {
+        std::cerr << "Cannot read archive '" << argv[1] << "'.\n";
+        return 1;
+    }
+    std::string query = argv[2];
+    int threads = 0;
+    for (int i = 3; i + 1 < argc; ++i) {
+        if (std::string(argv[i]) == "--threads") {
+            threads = atoi(argv[i + 1]);
+        }
+    }
+    ArchiveQuery engine(archive, threads);
+    std::vector<Player> pool = Game().allPlayers;
+
+    auto start = std::chrono::steady_clock::now();
+    if (query == "players") {
+        PlayerStatsStore<long long> totals = engine.playerTotals(pool);
+        std::vector<double> strikeRates, economyRates;
+        totals.strikeRates(strikeRates);
+        totals.economyRates(economyRates);
+        std::cout << "Player\tRuns\tBalls\tOuts\tStrike Rate\tWickets\tEconomy\n";
+        for (int id = 0; id < totals.size(); ++id) {
+            if (totals.column(BALLS_PLAYED)[id] == 0 && totals.column(BALLS_BOWLED)[id] == 0) {
+                continue;
+            }
+            std::string name = totals.names[id].empty() ? std::to_string(id) : totals.names[id];
+            std::cout << name << "\t" << totals.column(RUNS_SCORED)[id] << "\t" << totals.column(BALLS_PLAYED)[id]
+                      << "\t" << totals.column(DISMISSALS)[id] << "\t" << strikeRates[id] << "\t"
+                      << totals.column(WICKETS_TAKEN)[id] << "\t" << economyRates[id] << "\n";
+        }
+    } else if ((query == "runs" || query == "conceded" || query == "opens") && argc > 3) {
+        int playerId = findPlayerId(pool, argv[3]);
+        if (playerId == 0) {
+            std::cerr << "Unknown player '" << argv[3] << "'.\n";
+            return 1;
+        }
+        if (query == "opens") {
+            engine.openingRecord(playerId).print(std::cout);
+        } else {
+            engine.playerRuns(playerId, query == "conceded").print(std::cout);
+        }
+    } else {
+        printUsage(argv[0]);
+        return 1;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Scan speed goes to stderr so stdout holds only the answer
+    std::cerr << "Scanned " << archive.numDeliveries << " deliveries in " << archive.numMatches << " matches in "
+              << seconds << " s (" << archive.numDeliveries / seconds / 1e6 << "M deliveries/s, " << engine.numThreads
+              << " threads)\n";
+    return 0;
+}
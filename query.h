@@ -0,0 +1,253 @@
+#ifndef CRICKET_QUERY_H
+#define CRICKET_QUERY_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "match_archive.h"
+#include "player_stats.h"
+
+// --- PlayerRuns Definition ---
+// Runs off the bat for one player, as batsman (runs scored) or as bowler
+// (runs conceded), per ball and per match.
+struct PlayerRuns {
+    long long deliveries;
+    long long runs;
+    long long wickets; // Dismissals as batsman, wickets taken as bowler
+    long long matches; // Matches with at least one delivery
+    std::vector<long long> runsPerBall;  // runsPerBall[r] = deliveries worth r runs
+    std::vector<long long> runsPerMatch; // runsPerMatch[r] = matches with r runs in total
+
+    // Constructor: per-match totals up to 'maxRuns'
+    explicit PlayerRuns(int maxRuns = 0) :
+        deliveries(0),
+        runs(0),
+        wickets(0),
+        matches(0),
+        runsPerBall(8, 0),
+        runsPerMatch(maxRuns + 1, 0) {}
+
+    void merge(const PlayerRuns& other) {
+        deliveries += other.deliveries;
+        runs += other.runs;
+        wickets += other.wickets;
+        matches += other.matches;
+        for (size_t r = 0; r < runsPerBall.size(); ++r) {
+            runsPerBall[r] += other.runsPerBall[r];
+        }
+        for (size_t r = 0; r < runsPerMatch.size(); ++r) {
+            runsPerMatch[r] += other.runsPerMatch[r];
+        }
+    }
+
+    void print(std::ostream& out) const {
+        double balls = deliveries > 0 ? static_cast<double>(deliveries) : 1.0;
+        double games = matches > 0 ? static_cast<double>(matches) : 1.0;
+        out << "Matches: " << matches << "\n";
+        out << "Deliveries: " << deliveries << "\n";
+        out << "Runs: " << runs << "\n";
+        out << "Wickets: " << wickets << "\n";
+        out << "Runs per ball: " << runs / balls << "\n";
+        out << "Runs per match: " << runs / games << "\n";
+        out << "Runs\tPer ball\tPer match\n";
+        for (size_t r = 0; r < runsPerMatch.size() || r < runsPerBall.size(); ++r) {
+            long long perBall = r < runsPerBall.size() ? runsPerBall[r] : 0;
+            long long perMatch = r < runsPerMatch.size() ? runsPerMatch[r] : 0;
+            if (perBall == 0 && perMatch == 0) {
+                continue;
+            }
+            out << r << "\t" << perBall / balls << "\t" << perMatch / games << "\n";
+        }
+    }
+};
+
+// --- OpeningRecord Definition ---
+// Results of the innings in which one player faced their side's first ball.
+// Counted per innings: when the line-ups share a player (11-a-side formats)
+// they open for both sides, and each side's result is theirs once.
+struct OpeningRecord {
+    long long matches; // Innings opened
+    long long wins;
+    long long draws;
+    long long battingFirst; // Of 'matches', the ones where their side batted first
+
+    OpeningRecord() :
+        matches(0),
+        wins(0),
+        draws(0),
+        battingFirst(0) {}
+
+    void merge(const OpeningRecord& other) {
+        matches += other.matches;
+        wins += other.wins;
+        draws += other.draws;
+        battingFirst += other.battingFirst;
+    }
+
+    void print(std::ostream& out) const {
+        double n = matches > 0 ? static_cast<double>(matches) : 1.0;
+        out << "Innings opened: " << matches << "\n";
+        out << "Batting first: " << battingFirst << "\n";
+        out << "Win rate: " << wins / n << "\n";
+        out << "Draw rate: " << draws / n << "\n";
+        out << "Loss rate: " << (matches - wins - draws) / n << "\n";
+    }
+};
+
+// --- ArchiveQuery Class Definition ---
+// Filter / group-by / aggregate scans over a MatchArchive. Matches are split
+// into blocks that worker threads claim from a shared counter, each worker
+// folds its blocks into a private partial result, and the partials are
+// merged at the end. Predicates are written branch-free over the byte
+// columns so that the inner loops vectorize.
+class ArchiveQuery {
+public:
+    const MatchArchive& archive;
+    int numThreads;
+    size_t blockMatches; // Matches claimed by a worker at a time
+
+    // Constructor: 0 threads means one per hardware core
+    explicit ArchiveQuery(const MatchArchive& archive, int numThreads = 0) :
+        archive(archive),
+        numThreads(numThreads > 0 ? numThreads : static_cast<int>(std::thread::hardware_concurrency())),
+        blockMatches(1 << 14)
+    {
+        if (this->numThreads < 1) {
+            this->numThreads = 1;
+        }
+    }
+
+    // Runs 'scan(firstMatch, lastMatch, partial)' over every match and returns the merged partials
+    template <typename Partial, typename Scan>
+    Partial scanMatches(const Partial& empty, Scan scan) const {
+        std::vector<Partial> partials(numThreads, empty);
+        std::atomic<size_t> nextBlock(0);
+        size_t numBlocks = (archive.numMatches + blockMatches - 1) / blockMatches;
+        auto work = [&](Partial& partial) {
+            size_t block;
+            while ((block = nextBlock.fetch_add(1, std::memory_order_relaxed)) < numBlocks) {
+                size_t first = block * blockMatches;
+                size_t last = std::min(first + blockMatches, archive.numMatches);
+                scan(first, last, partial);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (int t = 1; t < numThreads; ++t) {
+            threads.emplace_back(work, std::ref(partials[t]));
+        }
+        work(partials[0]); // The calling thread works too
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        Partial result = empty;
+        for (const auto& partial : partials) {
+            result.merge(partial);
+        }
+        return result;
+    }
+
+    // Runs scored by 'playerId' (or conceded, if 'asBowler'), per ball and per match
+    PlayerRuns playerRuns(int playerId, bool asBowler) const {
+        const uint8_t* ids = asBowler ? archive.bowlerIds : archive.batsmanIds;
+        const uint8_t* runs = archive.runs;
+        const uint8_t* wickets = archive.wickets;
+        const uint64_t* firstDeliveries = archive.firstDeliveries;
+        uint8_t id = static_cast<uint8_t>(playerId);
+        int maxRuns = archive.header->log.maxDeliveries * 6;
+
+        return scanMatches(PlayerRuns(maxRuns), [=](size_t first, size_t last, PlayerRuns& partial) {
+            // Per-ball counts: one flat pass over the block's deliveries
+            size_t begin = firstDeliveries[first];
+            size_t end = firstDeliveries[last];
+            uint32_t counts[8] = {};
+            uint32_t wicketCount = 0;
+            for (size_t i = begin; i < end; ++i) {
+                uint8_t hit = ids[i] == id;
+                for (int r = 0; r < 8; ++r) {
+                    counts[r] += hit & (runs[i] == r);
+                }
+                wicketCount += hit & wickets[i];
+            }
+            for (int r = 0; r < 8; ++r) {
+                partial.deliveries += counts[r];
+                partial.runs += static_cast<long long>(r) * counts[r];
+                partial.runsPerBall[r] += counts[r];
+            }
+            partial.wickets += wicketCount;
+
+            // Per-match totals
+            for (size_t m = first; m < last; ++m) {
+                int matchRuns = 0;
+                int matchBalls = 0;
+                for (size_t i = firstDeliveries[m]; i < firstDeliveries[m + 1]; ++i) {
+                    int hit = ids[i] == id;
+                    matchRuns += hit * runs[i];
+                    matchBalls += hit;
+                }
+                if (matchBalls > 0) {
+                    partial.matches++;
+                    partial.runsPerMatch[std::min(matchRuns, maxRuns)]++;
+                }
+            }
+        });
+    }
+
+    // Results of every match 'playerId' opened the batting in
+    OpeningRecord openingRecord(int playerId) const {
+        const uint8_t* openers = archive.openers;
+        const uint8_t* chaseOpeners = archive.chaseOpeners;
+        const uint8_t* teamABattedFirst = archive.teamABattedFirst;
+        const uint8_t* results = archive.results;
+        uint8_t id = static_cast<uint8_t>(playerId);
+
+        return scanMatches(OpeningRecord(), [=](size_t first, size_t last, OpeningRecord& partial) {
+            uint32_t opened = 0;
+            uint32_t won = 0;
+            uint32_t drawn = 0;
+            uint32_t setFirst = 0;
+            for (size_t m = first; m < last; ++m) {
+                uint8_t setting = openers[m] == id;
+                uint8_t chasing = chaseOpeners[m] == id;
+                uint8_t settingSide = teamABattedFirst[m] ? RESULT_TEAM_A_WIN : RESULT_TEAM_B_WIN;
+                uint8_t chasingSide = RESULT_TEAM_A_WIN + RESULT_TEAM_B_WIN - settingSide;
+                opened += setting + chasing;
+                setFirst += setting;
+                won += (setting & (results[m] == settingSide)) + (chasing & (results[m] == chasingSide));
+                drawn += (setting + chasing) * (results[m] == RESULT_DRAW);
+            }
+            partial.matches += opened;
+            partial.wins += won;
+            partial.draws += drawn;
+            partial.battingFirst += setFirst;
+        });
+    }
+
+    // Every counter of every player, grouped by Player::id and named from 'pool'
+    PlayerStatsStore<long long> playerTotals(const std::vector<Player>& pool) const {
+        const uint8_t* batsmanIds = archive.batsmanIds;
+        const uint8_t* bowlerIds = archive.bowlerIds;
+        const uint8_t* runs = archive.runs;
+        const uint8_t* wickets = archive.wickets;
+        const uint64_t* firstDeliveries = archive.firstDeliveries;
+
+        // One row for every id a delivery column can hold
+        PlayerStatsStore<long long> empty(256);
+        for (const auto& player : pool) {
+            empty.names[player.id] = player.name;
+        }
+        return scanMatches(empty, [=](size_t first, size_t last, PlayerStatsStore<long long>& partial) {
+            for (size_t i = firstDeliveries[first]; i < firstDeliveries[last]; ++i) {
+                partial.recordDelivery(batsmanIds[i], bowlerIds[i], runs[i], wickets[i]);
+            }
+        });
+    }
+};
+
+#endif // CRICKET_QUERY_H
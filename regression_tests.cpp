@@ -0,0 +1,300 @@
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdlib>  // For mkstemp()
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h> // For close() and unlink()
+#include "event_log.h"
+#include "event_loop.h"
+#include "live_server.h"
+#include "match_state.h"
+#include "match_archive.h"
+#include "match_format.h"
+#include "query.h"
+#include "replay.h"
+#include "simulator.h"
+
+// --- Regression tests ---
+// Each test checks one behaviour end to end and prints what differed on
+// failure. Run one with `cricket_tests NAME`, or all of them with no
+// arguments; CTest registers each one separately.
+
+// A temporary file that is deleted when it goes out of scope
+struct TempFile {
+    std::string path;
+
+    TempFile() {
+        char pattern[] = "/tmp/cricket_testXXXXXX";
+        int fd = mkstemp(pattern);
+        if (fd >= 0) {
+            close(fd);
+            path = pattern;
+        }
+    }
+
+    ~TempFile() {
+        if (!path.empty()) {
+            unlink(path.c_str());
+        }
+    }
+};
+
+// Simulates 'numMatches' matches of one format with an event log at 'path'
+SimulationResults simulateWithLog(const FormatEntry& format, uint64_t seed, long long numMatches,
+                                  const std::string& path) {
+    Simulator simulator(seed);
+    simulator.setFormat(format.balls, format.players);
+    EventLogWriter log;
+    log.open(path, simulator.logHeader());
+    simulator.eventLog = &log;
+    SimulationResults results = simulator.run(numMatches);
+    log.close();
+    return results;
+}
+
+// Every match replayed from the log ends as it did in the simulation (the line-ups of
+// 11-a-side formats share player ids, so the toss must come from the log)
+bool testReplayMatchesSimulation(const char* formatName) {
+    const FormatEntry* format = findFormat(formatName);
+    TempFile file;
+    SimulationResults simulated = simulateWithLog(*format, 5, 200, file.path);
+
+    EventLogReader log;
+    if (!log.open(file.path)) {
+        std::cerr << "cannot read the log\n";
+        return false;
+    }
+    long long teamAWins = 0, teamBWins = 0, draws = 0, balls = 0, failed = 0;
+    Game game;
+    game.clock = Clock::instant();
+    for (size_t first = 0; first < log.numRecords; first = log.matchEnd(first)) {
+        if (!replayMatch(log, first, log.matchEnd(first), game, [](const DeliveryRecord&) {})) {
+            failed++;
+            continue;
+        }
+        int teamARuns = game.teamA.totalRuns;
+        int teamBRuns = game.teamB.totalRuns;
+        teamAWins += teamARuns > teamBRuns;
+        teamBWins += teamBRuns > teamARuns;
+        draws += teamARuns == teamBRuns;
+        balls += game.teamA.totalBallsBowled + game.teamB.totalBallsBowled;
+    }
+    if (failed > 0 || teamAWins != simulated.teamAWins || teamBWins != simulated.teamBWins ||
+        draws != simulated.draws || balls != simulated.balls) {
+        std::cerr << formatName << ": replayed A=" << teamAWins << " B=" << teamBWins << " D=" << draws
+                  << " balls=" << balls << " (" << failed << " failed), simulated A=" << simulated.teamAWins
+                  << " B=" << simulated.teamBWins << " D=" << simulated.draws << " balls=" << simulated.balls << "\n";
+        return false;
+    }
+    return true;
+}
+
+// The archive of a log splits wins and batting-first wins as the simulation did (with
+// shared player ids, telling the sides apart by id credited every match to TeamA), and
+// a player who opens for both sides wins exactly the matches that are not drawn
+bool testArchiveMatchesSimulation(const char* formatName) {
+    const FormatEntry* format = findFormat(formatName);
+    TempFile logFile;
+    TempFile archiveFile;
+    SimulationResults simulated = simulateWithLog(*format, 5, 200, logFile.path);
+
+    EventLogReader log;
+    MatchArchive archive;
+    if (!log.open(logFile.path) || !MatchArchive::build(log, archiveFile.path) || !archive.open(archiveFile.path)) {
+        std::cerr << "cannot build the archive\n";
+        return false;
+    }
+    long long teamAWins = 0, teamBWins = 0, draws = 0, battingFirstWins = 0, chasingWins = 0;
+    for (size_t m = 0; m < archive.numMatches; ++m) {
+        teamAWins += archive.results[m] == RESULT_TEAM_A_WIN;
+        teamBWins += archive.results[m] == RESULT_TEAM_B_WIN;
+        draws += archive.results[m] == RESULT_DRAW;
+        bool firstWon = archive.results[m] == (archive.teamABattedFirst[m] ? RESULT_TEAM_A_WIN : RESULT_TEAM_B_WIN);
+        bool chaseWon = archive.results[m] == (archive.teamABattedFirst[m] ? RESULT_TEAM_B_WIN : RESULT_TEAM_A_WIN);
+        battingFirstWins += firstWon;
+        chasingWins += chaseWon;
+    }
+    if (teamAWins != simulated.teamAWins || teamBWins != simulated.teamBWins || draws != simulated.draws ||
+        battingFirstWins != simulated.battingFirstWins || chasingWins != simulated.chasingWins) {
+        std::cerr << formatName << ": archived A=" << teamAWins << " B=" << teamBWins << " D=" << draws
+                  << " first=" << battingFirstWins << " chase=" << chasingWins << ", simulated A="
+                  << simulated.teamAWins << " B=" << simulated.teamBWins << " D=" << simulated.draws
+                  << " first=" << simulated.battingFirstWins << " chase=" << simulated.chasingWins << "\n";
+        return false;
+    }
+
+    int opener = archive.openers[0];
+    OpeningRecord opening = ArchiveQuery(archive, 1).openingRecord(opener);
+    long long bothSides = 0;
+    for (size_t m = 0; m < archive.numMatches; ++m) {
+        bothSides += archive.openers[m] == opener && archive.chaseOpeners[m] == opener;
+    }
+    if (bothSides > 0 && opening.wins != simulated.matches - simulated.draws) {
+        std::cerr << formatName << ": player " << opener << " opened " << opening.matches << " innings and won "
+                  << opening.wins << ", expected " << simulated.matches - simulated.draws << "\n";
+        return false;
+    }
+    return true;
+}
+
+// A snapshot of a paced match taken between balls carries on from the ball the match
+// was at: restored into another Game and played out, it ends as the paced match does
+bool testSnapshotPacedMatch() {
+    long long snapshots = 0;
+    for (long long matchIndex = 0; matchIndex < 20; ++matchIndex) {
+        Clock clock = Clock::instant();
+        EventLoop loop(clock);
+        PacedMatch paced(loop, 5, matchIndex, [](const LiveUpdate&) {});
+        paced.start();
+
+        // Step the loop until the match is part-way through an innings
+        const Game& playing = paced.game();
+        auto midInnings = [&playing]() {
+            return playing.inningsNum > 0 && playing.battingTeam->totalBallsBowled > 0 && !playing.isInningsFinished();
+        };
+        while (!loop.empty() && !midInnings()) {
+            loop.runUntil(loop.nextDueMicros());
+        }
+        if (loop.empty()) {
+            continue;
+        }
+        MatchState state;
+        if (!playing.saveState(state) || state.currentBall != playing.battingTeam->totalBallsBowled) {
+            std::cerr << "match " << matchIndex << ": snapshot at ball " << state.currentBall << " of an innings "
+                      << playing.battingTeam->totalBallsBowled << " balls in\n";
+            return false;
+        }
+        snapshots++;
+
+        Game restored;
+        if (!restored.restoreState(state)) {
+            std::cerr << "match " << matchIndex << ": cannot restore the snapshot\n";
+            return false;
+        }
+        restored.playToEnd();
+        loop.run();
+        for (int t = 0; t < 2; ++t) {
+            const Team& expected = t == 0 ? playing.teamA : playing.teamB;
+            const Team& actual = t == 0 ? restored.teamA : restored.teamB;
+            if (actual.totalRuns != expected.totalRuns || actual.totalWicketsLost != expected.totalWicketsLost ||
+                actual.totalBallsBowled != expected.totalBallsBowled) {
+                std::cerr << "match " << matchIndex << ", " << expected.name << ": restored " << actual.totalRuns
+                          << "/" << actual.totalWicketsLost << " in " << actual.totalBallsBowled << " balls, paced "
+                          << expected.totalRuns << "/" << expected.totalWicketsLost << " in "
+                          << expected.totalBallsBowled << " balls\n";
+                return false;
+            }
+        }
+    }
+    if (snapshots == 0) {
+        std::cerr << "no match was ever part-way through an innings\n";
+        return false;
+    }
+    return true;
+}
+
+// Connects to the Unix socket at 'path'; returns the fd or -1
+int connectUnix(const std::string& path) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// A subscriber that joins on the descriptor of one that left before the server's
+// next flush gets the snapshot of the matches in progress once, not once per join
+bool testLiveReconnectSnapshot() {
+    const int numChannels = 4;
+    TempFile socketFile;
+    LiveServer server(numChannels, 5, 1.0);
+    server.flushMicros = 300000; // Both joins fall before the first flush
+    std::string error;
+    if (!server.listenUnix(socketFile.path, error)) {
+        std::cerr << error << "\n";
+        return false;
+    }
+    std::thread serving([&server, &error]() { server.run(0.8, error); });
+
+    auto pause = []() { std::this_thread::sleep_for(std::chrono::milliseconds(50)); };
+    pause();
+    int leaving = connectUnix(socketFile.path);
+    pause(); // Accepted
+    close(leaving);
+    pause(); // Closed by the server, freeing its descriptor for the next accept
+    int joining = connectUnix(socketFile.path);
+    serving.join();
+
+    if (leaving < 0 || joining < 0) {
+        std::cerr << "cannot connect\n";
+        return false;
+    }
+    LiveHello hello;
+    std::vector<LiveUpdate> updates(1);
+    bool complete = recv(joining, &hello, sizeof(hello), MSG_WAITALL | MSG_DONTWAIT) == sizeof(hello);
+    while (recv(joining, &updates.back(), sizeof(LiveUpdate), MSG_WAITALL | MSG_DONTWAIT) == sizeof(LiveUpdate)) {
+        updates.emplace_back();
+    }
+    close(joining);
+    long long snapshots = 0;
+    for (size_t i = 0; i + 1 < updates.size(); ++i) {
+        snapshots += updates[i].type == LIVE_SNAPSHOT;
+    }
+    if (!complete || server.clientsAccepted != 2 || snapshots != 2 * numChannels) {
+        std::cerr << "accepted " << server.clientsAccepted << " clients; the second got "
+                  << (complete ? "" : "no hello and ") << snapshots << " snapshot records, expected "
+                  << 2 * numChannels << "\n";
+        return false;
+    }
+    return true;
+}
+
+// --- Test Table ---
+
+struct RegressionTest {
+    const char* name;
+    bool (*run)();
+};
+
+const std::vector<RegressionTest>& testTable() {
+    static const std::vector<RegressionTest> table = {
+        {"replay.t20", [] { return testReplayMatchesSimulation("t20"); }},
+        {"replay.odi", [] { return testReplayMatchesSimulation("odi"); }},
+        {"archive.t20", [] { return testArchiveMatchesSimulation("t20"); }},
+        {"archive.odi", [] { return testArchiveMatchesSimulation("odi"); }},
+        {"snapshot.paced", testSnapshotPacedMatch},
+        {"live.reconnect", testLiveReconnectSnapshot},
+    };
+    return table;
+}
+
+// --- Main Function ---
+// Usage: cricket_tests [NAME]
+int main(int argc, char* argv[]) {
+    std::string only = (argc > 1) ? argv[1] : "";
+    int failures = 0;
+    bool found = false;
+    for (const RegressionTest& test : testTable()) {
+        if (!only.empty() && only != test.name) {
+            continue;
+        }
+        found = true;
+        bool passed = test.run();
+        std::cout << (passed ? "PASS " : "FAIL ") << test.name << "\n";
+        failures += !passed;
+    }
+    if (!found) {
+        std::cerr << "Unknown test '" << only << "'.\n";
+        return 1;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,69 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "event_log.h"
+#include "game.h"
+#include "replay.h"
+#include "win_probability.h"
+
+// --- Main Function ---
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " LOG [MATCH_ID [--win-probability]]\n";
+        return 1;
+    }
+
+    EventLogReader log;
+    if (!log.open(argv[1])) {
+        std::cerr << "Cannot read event log '" << argv[1] << "'.\n";
+        return 1;
+    }
+
+    // Without a match id, describe the log
+    if (argc < 3) {
+        std::cout << "Deliveries: " << log.numRecords << "\n";
+        if (log.numRecords > 0) {
+            std::cout << "Matches: " << log.records[0].matchId << " to " << log.records[log.numRecords - 1].matchId
+                      << "\n";
+        }
+        std::cout << "Balls per innings: " << log.header->maxDeliveries << ", players per team: "
+                  << log.header->playersPerTeam << "\n";
+        return 0;
+    }
+
+    uint32_t matchId = static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10));
+    size_t first = log.findMatch(matchId);
+    if (first == log.numRecords || log.records[first].matchId != matchId) {
+        std::cerr << "Match " << matchId << " is not in the log.\n";
+        return 1;
+    }
+
+    // With --win-probability, print each side's chance of winning after every ball
+    Game game;
+    game.clock = Clock::instant();
+    bool trace = argc > 3 && std::string(argv[3]) == "--win-probability";
+    if (trace) {
+        game.winPredictor = findWinPredictor(log.header->maxDeliveries, log.header->playersPerTeam);
+        if (game.winPredictor == nullptr) {
+            std::cerr << "No win probability tables for this format.\n";
+            return 1;
+        }
+        std::cout << "Innings\tBall\tScore\tTeamA\tTeamB\tTie\n";
+    }
+    auto onBall = [&game, trace](const DeliveryRecord& record) {
+        float teamAWins, teamBWins, draw;
+        if (trace && game.winProbability(teamAWins, teamBWins, draw)) {
+            std::cout << record.innings() << "\t" << record.ball() + 1 << "\t" << game.battingTeam->totalRuns << "/"
+                      << game.battingTeam->totalWicketsLost << "\t" << teamAWins << "\t" << teamBWins << "\t"
+                      << draw << "\n";
+        }
+    };
+    if (!replayMatch(log, first, log.matchEnd(first), game, onBall)) {
+        std::cerr << "Match " << matchId << " does not match the log's line-ups.\n";
+        return 1;
+    }
+    if (!trace) {
+        game.displayMatchSummary();
+    }
+    return 0;
+}
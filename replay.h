@@ -0,0 +1,54 @@
+#ifndef CRICKET_REPLAY_H
+#define CRICKET_REPLAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include "event_log.h"
+#include "game.h"
+
+// --- Replay Helpers ---
+
+// Adds a header line-up (0 = unused slot) to 'team'; returns false on an unknown player id
+inline bool addLineup(Game& game, Team& team, const uint8_t* playerIds, int playersPerTeam) {
+    for (int i = 0; i < playersPerTeam && playerIds[i] != 0; ++i) {
+        if (playerIds[i] > game.allPlayers.size()) {
+            return false;
+        }
+        game.addToTeam(team, playerIds[i]);
+    }
+    return true;
+}
+
+// Rebuilds the Game scorecard of the match in records [first, end), calling onBall(record)
+// after each delivery; returns false if the log does not fit the line-ups
+template <typename OnBall>
+bool replayMatch(const EventLogReader& log, size_t first, size_t end, Game& game, OnBall onBall) {
+    const EventLogHeader& header = *log.header;
+    game.resetMatch();
+    game.maxDeliveries = header.maxDeliveries;
+    game.playersPerTeam = header.playersPerTeam;
+    if (!addLineup(game, game.teamA, header.teamAPlayerIds, header.playersPerTeam) ||
+        !addLineup(game, game.teamB, header.teamBPlayerIds, header.playersPerTeam)) {
+        return false;
+    }
+
+    // Every record carries the toss: the side batting first is the one that won it and chose to bat
+    game.applyTossChoice(log.records[first].teamABatsFirst(), 1);
+
+    size_t next = first;
+    for (int inningsNumber = 1; inningsNumber <= 2; ++inningsNumber) {
+        game.beginInnings(inningsNumber);
+        for (; next < end && log.records[next].innings() == inningsNumber; ++next) {
+            const DeliveryRecord& record = log.records[next];
+            if (game.currentBatsman == nullptr || game.currentBatsman->id != record.batsmanId ||
+                game.currentBowler->id != record.bowlerId) {
+                return false;
+            }
+            game.recordDelivery(record.runs(), record.wicket());
+            onBall(record);
+        }
+    }
+    return next == end;
+}
+
+#endif // CRICKET_REPLAY_H
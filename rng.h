@@ -0,0 +1,62 @@
+#ifndef CRICKET_RNG_H
+#define CRICKET_RNG_H
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+
+// --- Rng Class Definition ---
+// Small, seedable and splittable random number generator (SplitMix64).
+// Each Game owns one, so simulations never share hidden global state and
+// the same seed always replays the same match.
+class Rng {
+public:
+    uint64_t state;
+
+    // Constructor
+    explicit Rng(uint64_t seed = 0) : state(seed) {}
+
+    // Scrambles a 64-bit value (SplitMix64 finalizer)
+    static uint64_t mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Returns an independent stream derived from a master seed and a stream id.
+    // Stream i is the same no matter which thread asks for it.
+    static Rng forStream(uint64_t masterSeed, uint64_t streamId) {
+        return Rng(mix(masterSeed ^ mix(streamId + 0x9E3779B97F4A7C15ULL)));
+    }
+
+    // Returns a generator seeded from the OS entropy source and a high-resolution
+    // clock, so games started in the same second still get different seeds
+    static Rng fromEntropy() {
+        std::random_device device;
+        uint64_t bits = (static_cast<uint64_t>(device()) << 32) ^ device();
+        uint64_t ticks = static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+        return Rng(mix(bits ^ mix(ticks)));
+    }
+
+    // Returns the next 64 random bits
+    uint64_t next() {
+        state += 0x9E3779B97F4A7C15ULL;
+        return mix(state);
+    }
+
+    // Returns a uniform integer in [0, bound) without modulo bias (Lemire's method)
+    uint32_t below(uint32_t bound) {
+        uint64_t product = static_cast<uint64_t>(static_cast<uint32_t>(next() >> 32)) * bound;
+        uint32_t low = static_cast<uint32_t>(product);
+        if (low < bound) {
+            uint32_t threshold = -bound % bound;
+            while (low < threshold) {
+                product = static_cast<uint64_t>(static_cast<uint32_t>(next() >> 32)) * bound;
+                low = static_cast<uint32_t>(product);
+            }
+        }
+        return static_cast<uint32_t>(product >> 32);
+    }
+};
+
+#endif // CRICKET_RNG_H
@@ -0,0 +1,446 @@
+#ifndef CRICKET_SCORECARD_H
+#define CRICKET_SCORECARD_H
+
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unistd.h> // For write()
+#include "profiler.h"
+#include "team.h"
+
+// --- ScorecardRenderer Class Definition ---
+// Formats the scorecard into a preallocated buffer and sends each frame with
+// a single write(). Every line of the card is a fixed row: only rows marked
+// dirty (the batsman and bowler touched by a ball, plus the score lines) are
+// reformatted. In-place mode redraws just those rows on the terminal with
+// ANSI cursor moves instead of reprinting the card, and frames can be
+// rate-limited independently of how fast the match is simulated.
+class ScorecardRenderer {
+public:
+    int fd;                                     // Where frames are written
+    bool inPlace;                               // Redraw changed rows in place instead of scrolling
+    std::chrono::nanoseconds minFrameInterval;  // 0 = render every frame
+    long long framesWritten;
+    long long framesSkipped;                    // Rate-limited or still waiting on the previous frame
+
+    // Constructor: 'capacity' bytes are reserved for the frame buffer up front
+    explicit ScorecardRenderer(int fd = STDOUT_FILENO, size_t capacity = 8192) :
+        fd(fd),
+        inPlace(false),
+        minFrameInterval(0),
+        framesWritten(0),
+        framesSkipped(0),
+        teamA(nullptr),
+        teamB(nullptr),
+        teamASize(-1),
+        teamBSize(-1),
+        showTarget(false),
+        hasWinProbability(false),
+        showWinProbability(false),
+        winTeamA(0.0f),
+        winTeamB(0.0f),
+        winDraw(0.0f),
+        drawn(false),
+        pendingOffset(0)
+    {
+        frame.reserve(capacity);
+    }
+
+    // Limits rendering to at most 'fps' frames per second (0 = unlimited)
+    void setFrameRate(double fps) {
+        minFrameInterval = std::chrono::nanoseconds(fps > 0 ? static_cast<long long>(1e9 / fps) : 0);
+    }
+
+    // Shows a win probability line under the scores on the next frames
+    void setWinProbability(float teamAWins, float teamBWins, float draw) {
+        hasWinProbability = true;
+        winTeamA = teamAWins;
+        winTeamB = teamBWins;
+        winDraw = draw;
+    }
+
+    // Drops the win probability line from the next frames
+    void clearWinProbability() {
+        hasWinProbability = false;
+    }
+
+    // Forces every row to be reformatted (e.g. for a new match)
+    void markAllDirty() {
+        std::fill(dirty.begin(), dirty.end(), 1);
+    }
+
+    // Marks the row of one player of 'team' as changed
+    void markPlayerDirty(const Team& team, const Player* player) {
+        if (player == nullptr || team.players.empty()) {
+            return;
+        }
+        int index = static_cast<int>(player - team.players.data());
+        if (&team == teamA && index >= 0 && index < teamASize) {
+            dirty[FIRST_PLAYER_ROW + index] = 1;
+        } else if (&team == teamB && index >= 0 && index < teamBSize) {
+            dirty[FIRST_PLAYER_ROW + teamASize + index] = 1;
+        }
+    }
+
+    // Renders one frame of the scorecard. Returns false if the frame was skipped
+    // by the rate limit or because the previous frame has not been fully written
+    // yet; its changes are kept and go out with the next frame. 'force' ignores
+    // the rate limit (use it for the last frame of an innings).
+    bool render(const Team& a, const Team& b, int maxDeliveries, int inningsNum,
+                const Team* battingTeam, const Team* bowlingTeam, bool force = false) {
+        CRICKET_PROFILE_PHASE(PHASE_RENDER);
+        if (!flushPending()) {
+            framesSkipped++;
+            return false;
+        }
+        if (!force && minFrameInterval.count() > 0) {
+            auto now = std::chrono::steady_clock::now();
+            if (now - lastFrame < minFrameInterval) {
+                framesSkipped++;
+                return false;
+            }
+            lastFrame = now;
+        }
+
+        bool target = inningsNum == 2 && battingTeam != nullptr && bowlingTeam != nullptr;
+        buildLayout(a, b, inPlace || target, hasWinProbability);
+
+        // Score lines change on every ball
+        formatScore(TEAM_A_SCORE_ROW, a, maxDeliveries);
+        formatScore(TEAM_B_SCORE_ROW, b, maxDeliveries);
+        formatTarget(target ? battingTeam : nullptr, target ? bowlingTeam : nullptr);
+        formatWinProbability(a, b);
+        for (int i = 0; i < teamASize; ++i) {
+            if (dirty[FIRST_PLAYER_ROW + i]) {
+                formatPlayer(FIRST_PLAYER_ROW + i, a.players[i]);
+            }
+        }
+        for (int i = 0; i < teamBSize; ++i) {
+            if (dirty[FIRST_PLAYER_ROW + teamASize + i]) {
+                formatPlayer(FIRST_PLAYER_ROW + teamASize + i, b.players[i]);
+            }
+        }
+
+        frame.clear();
+        pendingOffset = 0;
+        if (inPlace && drawn) {
+            appendChangedRows();
+        } else {
+            appendFullCard();
+        }
+        std::fill(dirty.begin(), dirty.end(), 0);
+        drawn = true;
+
+        framesWritten++;
+        flushPending();
+        return true;
+    }
+
+    // Bytes of the current frame still waiting to be written
+    size_t pendingBytes() const {
+        return frame.size() - pendingOffset;
+    }
+
+    // Writes as much of the current frame as the fd accepts; returns true once it is all out
+    bool flushPending() {
+        while (pendingOffset < frame.size()) {
+            ssize_t n = write(fd, frame.data() + pendingOffset, frame.size() - pendingOffset);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    return false; // Non-blocking fd is full: try again next frame
+                }
+                pendingOffset = frame.size(); // Unwritable fd: drop the frame
+                break;
+            }
+            pendingOffset += n;
+        }
+        return true;
+    }
+
+private:
+    static const int ROW_CAPACITY = 128;
+    static const int TEAM_A_SCORE_ROW = 0;
+    static const int TEAM_B_SCORE_ROW = 1;
+    static const int TARGET_ROW = 2;
+    static const int NEEDS_ROW = 3;
+    static const int WIN_ROW = 4;
+    static const int FIRST_PLAYER_ROW = 5;
+
+    // One line of the card: a fixed text, or (row >= 0) a formatted row
+    struct Line {
+        int row;
+        std::string text;
+    };
+
+    const Team* teamA;
+    const Team* teamB;
+    int teamASize;
+    int teamBSize;
+    bool showTarget;
+    bool hasWinProbability;            // Set by setWinProbability() for the coming frames
+    bool showWinProbability;           // The layout has the win probability line
+    float winTeamA;
+    float winTeamB;
+    float winDraw;
+    bool drawn;                        // The card is on screen (in-place mode)
+    std::vector<Line> layout;
+    std::vector<int> rowLine;          // Line number of each row
+    std::vector<char> rowText;         // ROW_CAPACITY bytes per row
+    std::vector<int> rowLength;
+    std::vector<char> changed;         // Row text differs from what is on screen
+    std::vector<char> dirty;           // Row must be reformatted
+    std::vector<char> frame;
+    size_t pendingOffset;
+    std::chrono::steady_clock::time_point lastFrame;
+
+    // Rebuilds the line layout when the teams or the target lines change
+    void buildLayout(const Team& a, const Team& b, bool withTarget, bool withWinProbability) {
+        int sizeA = static_cast<int>(a.players.size());
+        int sizeB = static_cast<int>(b.players.size());
+        if (&a == teamA && &b == teamB && sizeA == teamASize && sizeB == teamBSize && withTarget == showTarget &&
+            withWinProbability == showWinProbability && !layout.empty()) {
+            return;
+        }
+        teamA = &a;
+        teamB = &b;
+        teamASize = sizeA;
+        teamBSize = sizeB;
+        showTarget = withTarget;
+        showWinProbability = withWinProbability;
+
+        int rows = FIRST_PLAYER_ROW + sizeA + sizeB;
+        rowText.assign(static_cast<size_t>(rows) * ROW_CAPACITY, 0);
+        rowLength.assign(rows, 0);
+        changed.assign(rows, 1);
+        dirty.assign(rows, 1);
+        rowLine.assign(rows, -1);
+        drawn = false;
+
+        layout.clear();
+        addLine(-1, "");
+        addLine(-1, "\t----------------------------------");
+        addLine(-1, "\t|         SCORECARD              |");
+        addLine(-1, "\t----------------------------------");
+        addLine(TEAM_A_SCORE_ROW, "");
+        addLine(TEAM_B_SCORE_ROW, "");
+        if (withTarget) {
+            addLine(TARGET_ROW, "");
+            addLine(NEEDS_ROW, "");
+        }
+        if (withWinProbability) {
+            addLine(WIN_ROW, "");
+        }
+        addLine(-1, "");
+        addLine(-1, "\tBatsman Stats (" + a.name + "):");
+        addLine(-1, "\t---------------");
+        for (int i = 0; i < sizeA; ++i) {
+            addLine(FIRST_PLAYER_ROW + i, "");
+        }
+        addLine(-1, "");
+        addLine(-1, "\tBatsman Stats (" + b.name + "):");
+        addLine(-1, "\t---------------");
+        for (int i = 0; i < sizeB; ++i) {
+            addLine(FIRST_PLAYER_ROW + sizeA + i, "");
+        }
+        addLine(-1, "\t----------------------------------");
+        addLine(-1, "");
+    }
+
+    void addLine(int row, const std::string& text) {
+        if (row >= 0) {
+            rowLine[row] = static_cast<int>(layout.size());
+        }
+        Line line = {row, text};
+        layout.push_back(line);
+    }
+
+    // Small append-only formatter over a fixed row slot
+    struct RowWriter {
+        char* out;
+        int length;
+
+        void text(const char* s, size_t n) {
+            n = std::min(n, static_cast<size_t>(ROW_CAPACITY - length));
+            std::memcpy(out + length, s, n);
+            length += static_cast<int>(n);
+        }
+        void text(const char* s) {
+            text(s, std::strlen(s));
+        }
+        void text(const std::string& s) {
+            text(s.data(), s.size());
+        }
+        // 'fraction' as a percentage with one decimal, e.g. "63.2%"
+        void percent(float fraction) {
+            long long tenths = static_cast<long long>(fraction * 1000.0f + 0.5f);
+            number(tenths / 10);
+            text(".");
+            number(tenths % 10);
+            text("%");
+        }
+        void number(long long value) {
+            char digits[24];
+            int n = 0;
+            bool negative = value < 0;
+            unsigned long long v = negative ? 0ULL - static_cast<unsigned long long>(value) : value;
+            do {
+                digits[n++] = static_cast<char>('0' + v % 10);
+                v /= 10;
+            } while (v != 0);
+            if (negative) {
+                digits[n++] = '-';
+            }
+            while (n > 0 && length < ROW_CAPACITY) {
+                out[length++] = digits[--n];
+            }
+        }
+    };
+
+    // Starts reformatting a row in the scratch slot; finishRow() records whether its text changed
+    RowWriter beginRow() {
+        RowWriter writer = {scratch, 0};
+        return writer;
+    }
+
+    void finishRow(int row, const RowWriter& writer) {
+        char* slot = &rowText[static_cast<size_t>(row) * ROW_CAPACITY];
+        if (writer.length != rowLength[row] || std::memcmp(slot, writer.out, writer.length) != 0) {
+            std::memcpy(slot, writer.out, writer.length);
+            rowLength[row] = writer.length;
+            changed[row] = 1;
+        }
+    }
+
+    char scratch[ROW_CAPACITY];
+
+    // "\t<Team> Score: <runs>/<wickets>\tBalls: <balls>/<max>"
+    void formatScore(int row, const Team& team, int maxDeliveries) {
+        RowWriter w = beginRow();
+        w.text("\t");
+        w.text(team.name);
+        w.text(" Score: ");
+        w.number(team.totalRuns);
+        w.text("/");
+        w.number(team.totalWicketsLost);
+        w.text("\tBalls: ");
+        w.number(team.totalBallsBowled);
+        w.text("/");
+        w.number(maxDeliveries);
+        finishRow(row, w);
+    }
+
+    // Target lines of innings 2 (blank rows before that, in place)
+    void formatTarget(const Team* battingTeam, const Team* bowlingTeam) {
+        if (!showTarget) {
+            return;
+        }
+        RowWriter target = beginRow();
+        if (battingTeam != nullptr) {
+            target.text("\tTarget for ");
+            target.text(battingTeam->name);
+            target.text(": ");
+            target.number(bowlingTeam->totalRuns + 1);
+            target.text(" runs.");
+        }
+        finishRow(TARGET_ROW, target);
+
+        RowWriter needs = beginRow();
+        if (battingTeam != nullptr) {
+            needs.text("\t");
+            needs.text(battingTeam->name);
+            needs.text(" needs ");
+            needs.number((bowlingTeam->totalRuns + 1) - battingTeam->totalRuns);
+            needs.text(" runs to win.");
+        }
+        finishRow(NEEDS_ROW, needs);
+    }
+
+    // "\tWin probability: <TeamA> <p>%, <TeamB> <p>%, tie <p>%"
+    void formatWinProbability(const Team& a, const Team& b) {
+        if (!showWinProbability) {
+            return;
+        }
+        RowWriter w = beginRow();
+        w.text("\tWin probability: ");
+        w.text(a.name);
+        w.text(" ");
+        w.percent(winTeamA);
+        w.text(", ");
+        w.text(b.name);
+        w.text(" ");
+        w.percent(winTeamB);
+        w.text(", tie ");
+        w.percent(winDraw);
+        finishRow(WIN_ROW, w);
+    }
+
+    // Same text as Player::displayStats()
+    void formatPlayer(int row, const Player& player) {
+        RowWriter w = beginRow();
+        w.text("\t");
+        w.text(player.name);
+        w.text("\t\tRuns: ");
+        w.number(player.runsScored);
+        w.text("\tBalls: ");
+        w.number(player.ballsPlayed);
+        w.text("\tWickets: ");
+        w.number(player.wicketsTaken);
+        w.text("\tRuns Given: ");
+        w.number(player.runsGiven);
+        finishRow(row, w);
+    }
+
+    void append(const char* s, size_t n) {
+        frame.insert(frame.end(), s, s + n);
+    }
+
+    void append(const char* s) {
+        append(s, std::strlen(s));
+    }
+
+    void appendRow(int row) {
+        append(&rowText[static_cast<size_t>(row) * ROW_CAPACITY], rowLength[row]);
+    }
+
+    // The whole card, line by line
+    void appendFullCard() {
+        for (const Line& line : layout) {
+            if (line.row >= 0) {
+                appendRow(line.row);
+                changed[line.row] = 0;
+            } else {
+                append(line.text.data(), line.text.size());
+            }
+            append("\n");
+        }
+        if (inPlace) {
+            append("\x1b" "7"); // Save the cursor below the card for later in-place updates
+        }
+    }
+
+    // Only the rows whose text changed, each redrawn at its line above the saved cursor
+    void appendChangedRows() {
+        int lines = static_cast<int>(layout.size());
+        for (size_t row = 0; row < changed.size(); ++row) {
+            if (!changed[row] || rowLine[row] < 0) {
+                continue;
+            }
+            RowWriter move = beginRow();
+            move.text("\x1b" "8\x1b[");
+            move.number(lines - rowLine[row]);
+            move.text("F\x1b[2K");
+            append(move.out, move.length);
+            appendRow(static_cast<int>(row));
+            changed[row] = 0;
+        }
+        append("\x1b" "8");
+    }
+};
+
+#endif // CRICKET_SCORECARD_H
@@ -0,0 +1,256 @@
+#ifndef CRICKET_SIMULATOR_H
+#define CRICKET_SIMULATOR_H
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include "event_log.h"
+#include "game.h"
+#include "innings_engine.h"
+#include "player_stats.h"
+#include "rng.h"
+
+// --- SimulationResults Definition ---
+// Aggregate outcome of a batch of headless matches
+struct SimulationResults {
+    long long matches = 0;
+    long long balls = 0;
+    long long teamAWins = 0;
+    long long teamBWins = 0;
+    long long draws = 0;
+    long long battingFirstWins = 0;
+    long long chasingWins = 0;
+    std::vector<long long> firstInningsScores;  // Histogram: index = runs, value = innings count
+    std::vector<long long> secondInningsScores; // (grown on demand when extras push a score past 6 a ball)
+    PlayerStatsStore<long long> playerTotals;   // Season totals keyed by Player::id
+
+    // Sizes the score histograms for innings of 'maxDeliveries' balls and the player rows for the pool
+    SimulationResults(int maxDeliveries, const std::vector<Player>& pool) :
+        firstInningsScores(maxDeliveries * 6 + 1, 0),
+        secondInningsScores(maxDeliveries * 6 + 1, 0),
+        playerTotals(PlayerStatsStore<long long>::fromPool(pool)) {}
+
+    // Sizes the results for the game's format and player pool
+    explicit SimulationResults(const Game& game) :
+        SimulationResults(game.maxDeliveries, game.allPlayers) {}
+
+    // Counts one innings of 'runs' in a score histogram
+    static void countScore(std::vector<long long>& histogram, int runs) {
+        if (runs >= static_cast<int>(histogram.size())) {
+            histogram.resize(runs + 1, 0);
+        }
+        histogram[runs]++;
+    }
+
+    // Adds another batch of results into this one
+    void merge(const SimulationResults& other) {
+        matches += other.matches;
+        balls += other.balls;
+        teamAWins += other.teamAWins;
+        teamBWins += other.teamBWins;
+        draws += other.draws;
+        battingFirstWins += other.battingFirstWins;
+        chasingWins += other.chasingWins;
+        if (other.firstInningsScores.size() > firstInningsScores.size()) {
+            firstInningsScores.resize(other.firstInningsScores.size(), 0);
+        }
+        if (other.secondInningsScores.size() > secondInningsScores.size()) {
+            secondInningsScores.resize(other.secondInningsScores.size(), 0);
+        }
+        for (size_t i = 0; i < other.firstInningsScores.size(); ++i) {
+            firstInningsScores[i] += other.firstInningsScores[i];
+        }
+        for (size_t i = 0; i < other.secondInningsScores.size(); ++i) {
+            secondInningsScores[i] += other.secondInningsScores[i];
+        }
+        playerTotals.accumulate(other.playerTotals);
+    }
+
+    // Prints win/draw rates and the innings score distributions
+    void print(std::ostream& out) const {
+        double n = matches > 0 ? static_cast<double>(matches) : 1.0;
+        out << "Matches: " << matches << "\n";
+        out << "Balls: " << balls << "\n";
+        out << "TeamA win rate: " << teamAWins / n << "\n";
+        out << "TeamB win rate: " << teamBWins / n << "\n";
+        out << "Draw rate: " << draws / n << "\n";
+        out << "Batting first win rate: " << battingFirstWins / n << "\n";
+        out << "Chasing win rate: " << chasingWins / n << "\n";
+        out << "Runs\tInnings 1\tInnings 2\n";
+        size_t maxRuns = std::max(firstInningsScores.size(), secondInningsScores.size());
+        for (size_t runs = 0; runs < maxRuns; ++runs) {
+            long long first = runs < firstInningsScores.size() ? firstInningsScores[runs] : 0;
+            long long second = runs < secondInningsScores.size() ? secondInningsScores[runs] : 0;
+            if (first == 0 && second == 0) {
+                continue;
+            }
+            out << runs << "\t" << first / n << "\t" << second / n << "\n";
+        }
+
+        std::vector<double> strikeRates, economyRates;
+        playerTotals.strikeRates(strikeRates);
+        playerTotals.economyRates(economyRates);
+        out << "Player\tRuns\tBalls\tStrike Rate\tWickets\tEconomy\n";
+        for (int id = 0; id < playerTotals.size(); ++id) {
+            if (playerTotals.column(BALLS_PLAYED)[id] == 0 && playerTotals.column(BALLS_BOWLED)[id] == 0) {
+                continue;
+            }
+            out << playerTotals.names[id] << "\t" << playerTotals.column(RUNS_SCORED)[id]
+                << "\t" << playerTotals.column(BALLS_PLAYED)[id] << "\t" << strikeRates[id]
+                << "\t" << playerTotals.column(WICKETS_TAKEN)[id] << "\t" << economyRates[id] << "\n";
+        }
+    }
+};
+
+// Player ids for one side of a headless match of 'playersPerTeam' players.
+// Teams are disjoint when the pool is big enough, otherwise both sides field
+// the first 'playersPerTeam' players of the pool.
+inline std::vector<int> defaultLineup(int team, int playersPerTeam, int poolSize) {
+    int first = (2 * playersPerTeam <= poolSize) ? 1 + team * playersPerTeam : 1;
+    std::vector<int> ids;
+    for (int i = 0; i < playersPerTeam; ++i) {
+        ids.push_back(first + i);
+    }
+    return ids;
+}
+
+// --- Simulator Class Definition ---
+// Runs complete matches (toss, both innings, result) with no pauses and no console I/O
+class Simulator {
+public:
+    Game game;
+    std::vector<int> teamAPlayerIds;
+    std::vector<int> teamBPlayerIds;
+    uint64_t masterSeed;
+    EventLogWriter* eventLog; // If set, every delivery is appended to it
+    bool realisticInnings;    // Play innings on the InningsEngine (two batsmen, overs, extras) instead of Game's loop
+    InningsEngine innings;
+
+    // Constructor: TeamA and TeamB default to the first 8 players of the pool
+    explicit Simulator(uint64_t masterSeed = 0) :
+        teamAPlayerIds({1, 2, 3, 4}),
+        teamBPlayerIds({5, 6, 7, 8}),
+        masterSeed(masterSeed),
+        eventLog(nullptr),
+        realisticInnings(false) {}
+
+    // Header describing this simulator's matches, for an event log
+    EventLogHeader logHeader() const {
+        return EventLogHeader::make(game.maxDeliveries, teamAPlayerIds, teamBPlayerIds);
+    }
+
+    // Switches to innings of 'balls' deliveries and teams of 'players' (default lineups)
+    void setFormat(int balls, int players) {
+        game.maxDeliveries = balls;
+        game.playersPerTeam = players;
+        teamAPlayerIds = defaultLineup(0, players, game.allPlayers.size());
+        teamBPlayerIds = defaultLineup(1, players, game.allPlayers.size());
+    }
+
+    // Empty results sized for this simulator's format and player pool
+    SimulationResults makeResults() const {
+        return SimulationResults(game);
+    }
+
+    // Resets the game for match number 'matchIndex' on its own RNG stream and does the toss
+    void setUpMatch(long long matchIndex) {
+        game.fieldTeams(teamAPlayerIds, teamBPlayerIds);
+        game.rng = Rng::forStream(masterSeed, matchIndex);
+        game.matchIndex = static_cast<uint64_t>(matchIndex);
+
+        // Toss: the call never changes the odds, the winner picks Bat or Bowl at random
+        game.decideToss(1, 0);
+    }
+
+    // Plays match number 'matchIndex' on its own RNG stream and records its outcome
+    void playMatch(long long matchIndex, SimulationResults& results) {
+        setUpMatch(matchIndex);
+        simulateInnings(1, matchIndex);
+        Team* firstBatting = game.battingTeam;
+        recordFirstInnings(*firstBatting, results);
+        simulateInnings(2, matchIndex);
+        recordMatch(*firstBatting, *game.battingTeam, results);
+    }
+
+    // Plays one innings, appending every delivery to the event log if there is one
+    // (the log holds Game-loop innings only; realistic innings are not logged)
+    void simulateInnings(int inningsNumber, long long matchIndex) {
+        if (realisticInnings) {
+            innings.playInnings(game, inningsNumber);
+            return;
+        }
+        if (eventLog == nullptr) {
+            game.simulateInnings(inningsNumber);
+            return;
+        }
+        EventLogWriter* log = eventLog;
+        uint32_t matchId = static_cast<uint32_t>(matchIndex);
+        const Game* playing = &game;
+        game.simulateInnings(inningsNumber, [log, matchId, inningsNumber, playing](int ball, const Player& striker,
+                                                                                   const Player& bowler, int runs) {
+            bool teamABatsFirst = (playing->battingTeam == &playing->teamA) == (inningsNumber == 1);
+            log->append(DeliveryRecord::make(matchId, inningsNumber, ball, striker.id, bowler.id, runs, striker.isOut,
+                                             teamABatsFirst));
+        });
+    }
+
+    // Same match as playMatch(), but every ball is drawn on game.scorecard
+    void playMatchLive(long long matchIndex, SimulationResults& results) {
+        setUpMatch(matchIndex);
+        game.simulateInningsLive(1);
+        Team* firstBatting = game.battingTeam;
+        recordFirstInnings(*firstBatting, results);
+        game.simulateInningsLive(2);
+        recordMatch(*firstBatting, *game.battingTeam, results);
+    }
+
+    // Innings 2 clears every isOut flag, so first-innings dismissals are counted after innings 1
+    void recordFirstInnings(const Team& firstBatting, SimulationResults& results) const {
+        for (const auto& player : firstBatting.players) {
+            results.playerTotals.column(DISMISSALS)[player.id] += player.isOut;
+        }
+    }
+
+    // Records the outcome of a finished match
+    void recordMatch(const Team& firstBatting, const Team& secondBatting, SimulationResults& results) const {
+        results.matches++;
+        results.balls += game.teamA.totalBallsBowled + game.teamB.totalBallsBowled;
+        SimulationResults::countScore(results.firstInningsScores, firstBatting.totalRuns);
+        SimulationResults::countScore(results.secondInningsScores, secondBatting.totalRuns);
+        for (const Team* team : {&game.teamA, &game.teamB}) {
+            for (const auto& player : team->players) {
+                results.playerTotals.addPlayerMatch(player);
+            }
+        }
+
+        if (game.teamA.totalRuns > game.teamB.totalRuns) {
+            results.teamAWins++;
+        } else if (game.teamB.totalRuns > game.teamA.totalRuns) {
+            results.teamBWins++;
+        } else {
+            results.draws++;
+        }
+        if (firstBatting.totalRuns > secondBatting.totalRuns) {
+            results.battingFirstWins++;
+        } else if (secondBatting.totalRuns > firstBatting.totalRuns) {
+            results.chasingWins++;
+        }
+    }
+
+    // Plays matches [first, last) into 'results'
+    void runRange(long long first, long long last, SimulationResults& results) {
+        for (long long i = first; i < last; ++i) {
+            playMatch(i, results);
+        }
+    }
+
+    // Plays 'numMatches' matches and returns the aggregate results
+    SimulationResults run(long long numMatches) {
+        SimulationResults results = makeResults();
+        runRange(0, numMatches, results);
+        return results;
+    }
+};
+
+#endif // CRICKET_SIMULATOR_H
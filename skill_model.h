@@ -0,0 +1,173 @@
+#ifndef CRICKET_SKILL_MODEL_H
+#define CRICKET_SKILL_MODEL_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "rng.h"
+#include "team.h"
+
+// --- AliasTable Definition ---
+// Walker/Vose alias table over 'N' outcomes (by default the NUM_OUTCOMES
+// outcomes of a delivery): any distribution is sampled in O(1) from one 64-bit
+// random draw. The high 32 bits pick a column, the low 32 bits decide between
+// the column's own outcome and its alias, with a select instead of a branch.
+template <int N = NUM_OUTCOMES>
+struct AliasTable {
+    uint32_t threshold[N]; // Keep the column's own outcome when the low bits fall below this
+    uint8_t alias[N];      // Outcome taken otherwise
+
+    // Builds the table for 'probabilities' (N non-negative values summing to 1)
+    void build(const double* probabilities) {
+        double scaled[N];
+        int small[N], large[N];
+        int numSmall = 0, numLarge = 0;
+        for (int k = 0; k < N; ++k) {
+            scaled[k] = probabilities[k] * N;
+            if (scaled[k] < 1.0) {
+                small[numSmall++] = k;
+            } else {
+                large[numLarge++] = k;
+            }
+        }
+        while (numSmall > 0 && numLarge > 0) {
+            int s = small[--numSmall];
+            int l = large[numLarge - 1];
+            setColumn(s, scaled[s], l);
+            scaled[l] -= 1.0 - scaled[s];
+            if (scaled[l] < 1.0) {
+                numLarge--;
+                small[numSmall++] = l;
+            }
+        }
+        // Whatever is left is full up to rounding
+        while (numLarge > 0) {
+            int l = large[--numLarge];
+            setColumn(l, 1.0, l);
+        }
+        while (numSmall > 0) {
+            int s = small[--numSmall];
+            setColumn(s, 1.0, s);
+        }
+    }
+
+    // Outcome for 64 random bits. Picking the column by multiply-shift skips
+    // Lemire's rejection step; its bias is below N in 2^32.
+    int sample(uint64_t bits) const {
+        uint32_t column = static_cast<uint32_t>(((bits >> 32) * N) >> 32);
+        return static_cast<uint32_t>(bits) < threshold[column] ? static_cast<int>(column) : alias[column];
+    }
+
+private:
+    // Column 'k' keeps outcome k with probability 'keep' and gives 'other' the rest
+    void setColumn(int k, double keep, int other) {
+        double bound = keep * 4294967296.0;
+        threshold[k] = bound >= 4294967295.0 ? 0xFFFFFFFFu : static_cast<uint32_t>(bound);
+        alias[k] = static_cast<uint8_t>(keep >= 1.0 ? k : other);
+    }
+};
+
+// --- SkillModel Class Definition ---
+// Turns a batsman's and a bowler's profiles into the outcome distribution of
+// the balls between them (the product of their weights, normalized) and keeps
+// one alias table per (batsman, bowler) pair. A table is rebuilt only when
+// either player's profileStamp differs from the one it was built for, so the
+// per-ball cost is one lookup, one stamp check and one draw.
+class SkillModel {
+public:
+    // Constructor: no tables until resize()
+    SkillModel() :
+        stride(0),
+        tablesBuilt(0) {}
+
+    // Makes room for players with ids up to 'maxPlayerId'; every table is rebuilt on first use
+    void resize(int maxPlayerId) {
+        stride = maxPlayerId + 1;
+        entries.assign(static_cast<size_t>(stride) * stride, Entry());
+    }
+
+    // Draws the runs (0-6, 0 = wicket) off one ball from 'bowler' to 'batsman'
+    int sample(const Player& batsman, const Player& bowler, Rng& rng) {
+        Entry& entry = entries[batsman.id * stride + bowler.id];
+        if (entry.batsmanStamp != batsman.profileStamp || entry.bowlerStamp != bowler.profileStamp) {
+            rebuild(entry, batsman, bowler);
+        }
+        return entry.table.sample(rng.next());
+    }
+
+    // Probability of each outcome when 'batsman' faces 'bowler'
+    static void matchupDistribution(const Player& batsman, const Player& bowler, double* probabilities) {
+        double total = 0.0;
+        for (int k = 0; k < NUM_OUTCOMES; ++k) {
+            probabilities[k] = static_cast<double>(batsman.batting.weights[k]) * bowler.bowling.weights[k];
+            total += probabilities[k];
+        }
+        for (int k = 0; k < NUM_OUTCOMES; ++k) {
+            probabilities[k] = total > 0.0 ? probabilities[k] / total : 1.0 / NUM_OUTCOMES;
+        }
+    }
+
+    // Number of alias tables built so far
+    long long rebuilds() const {
+        return tablesBuilt;
+    }
+
+private:
+    // Stamps start at a value no Player carries, so each pair is built on first use
+    struct Entry {
+        AliasTable<> table;
+        uint32_t batsmanStamp = 0xFFFFFFFFu;
+        uint32_t bowlerStamp = 0xFFFFFFFFu;
+    };
+
+    int stride;
+    std::vector<Entry> entries; // Row = batsman id, column = bowler id
+    long long tablesBuilt;
+
+    void rebuild(Entry& entry, const Player& batsman, const Player& bowler) {
+        double probabilities[NUM_OUTCOMES];
+        matchupDistribution(batsman, bowler, probabilities);
+        entry.table.build(probabilities);
+        entry.batsmanStamp = batsman.profileStamp;
+        entry.bowlerStamp = bowler.profileStamp;
+        tablesBuilt++;
+    }
+};
+
+// --- Default Profiles ---
+
+// Gives the named players of the standard pool their batting and bowling
+// profiles (weights for 0, 1, 2, 3, 4, 5 and 6 runs). Unknown names stay neutral.
+inline void applyDefaultProfiles(std::vector<Player>& pool) {
+    struct NamedProfile {
+        const char* name;
+        SkillProfile batting;
+        SkillProfile bowling;
+    };
+    const SkillProfile topOrderBowling(0.8f, 1.0f, 1.0f, 1.0f, 1.15f, 1.0f, 1.25f);
+    const SkillProfile tailBatting(1.7f, 1.15f, 1.0f, 0.9f, 0.75f, 0.8f, 0.55f);
+    const NamedProfile profiles[] = {
+        {"Virat", SkillProfile(0.6f, 1.3f, 1.25f, 1.0f, 1.2f, 0.8f, 0.9f), topOrderBowling},
+        {"Rohit", SkillProfile(0.75f, 1.0f, 0.95f, 0.8f, 1.2f, 0.9f, 1.4f), topOrderBowling},
+        {"Dhawan", SkillProfile(0.85f, 1.1f, 1.0f, 0.9f, 1.3f, 0.9f, 0.95f), topOrderBowling},
+        {"Rahul", SkillProfile(0.7f, 1.2f, 1.15f, 0.95f, 1.1f, 0.85f, 1.0f), topOrderBowling},
+        {"Hardik", SkillProfile(0.95f, 0.9f, 0.9f, 0.8f, 1.1f, 1.0f, 1.35f),
+                   SkillProfile(1.2f, 1.0f, 1.0f, 1.0f, 1.05f, 1.0f, 1.1f)},
+        {"Jadeja", SkillProfile(0.9f, 1.1f, 1.1f, 0.9f, 1.0f, 0.9f, 1.0f),
+                   SkillProfile(1.3f, 1.2f, 1.0f, 0.9f, 0.85f, 0.9f, 0.8f)},
+        {"Bumrah", tailBatting, SkillProfile(1.7f, 1.25f, 1.0f, 0.85f, 0.7f, 0.8f, 0.5f)},
+        {"Shami", tailBatting, SkillProfile(1.5f, 1.1f, 1.0f, 0.9f, 0.85f, 0.85f, 0.65f)},
+        {"Yuzvendra", tailBatting, SkillProfile(1.45f, 0.95f, 0.9f, 0.85f, 0.9f, 1.0f, 1.05f)},
+        {"Kuldeep", tailBatting, SkillProfile(1.5f, 1.0f, 0.95f, 0.85f, 0.85f, 0.95f, 0.9f)},
+        {"Rishabh", SkillProfile(0.95f, 0.85f, 0.9f, 0.8f, 1.25f, 1.0f, 1.5f), topOrderBowling},
+    };
+    for (auto& player : pool) {
+        for (const auto& profile : profiles) {
+            if (player.name == profile.name) {
+                player.setProfiles(profile.batting, profile.bowling);
+            }
+        }
+    }
+}
+
+#endif // CRICKET_SKILL_MODEL_H
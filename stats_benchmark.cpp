@@ -0,0 +1,138 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <cstdlib>  // For atoll()
+#include "game.h"
+#include "player_stats.h"
+#include "rng.h"
+
+// One pre-generated delivery, so both layouts aggregate identical input
+struct Delivery {
+    int batsmanId;
+    int bowlerId;
+    int runs;
+};
+
+const int DELIVERIES_PER_MATCH = 12;
+
+// --- Current layout: Player records (array of structs) ---
+long long aggregateWithPlayers(const std::vector<Player>& pool, const std::vector<Delivery>& deliveries,
+                               long long totalDeliveries, std::vector<double>& strikeRates) {
+    std::vector<Player> match = pool;
+    std::vector<Player> season = pool;
+    long long done = 0;
+    while (done < totalDeliveries) {
+        for (size_t start = 0; start < deliveries.size() && done < totalDeliveries;
+             start += DELIVERIES_PER_MATCH, done += DELIVERIES_PER_MATCH) {
+            // Per-match reset
+            for (auto& player : match) {
+                player.runsScored = 0;
+                player.ballsPlayed = 0;
+                player.ballsBowled = 0;
+                player.runsGiven = 0;
+                player.wicketsTaken = 0;
+                player.isOut = false;
+            }
+            for (size_t i = start; i < start + DELIVERIES_PER_MATCH; ++i) {
+                const Delivery& d = deliveries[i];
+                Player& batsman = match[d.batsmanId - 1];
+                Player& bowler = match[d.bowlerId - 1];
+                batsman.runsScored += d.runs;
+                batsman.ballsPlayed++;
+                batsman.isOut = batsman.isOut || d.runs == 0;
+                bowler.ballsBowled++;
+                bowler.runsGiven += d.runs;
+                bowler.wicketsTaken += (d.runs == 0);
+            }
+            // Season totals
+            for (size_t p = 0; p < match.size(); ++p) {
+                season[p].runsScored += match[p].runsScored;
+                season[p].ballsPlayed += match[p].ballsPlayed;
+                season[p].ballsBowled += match[p].ballsBowled;
+                season[p].runsGiven += match[p].runsGiven;
+                season[p].wicketsTaken += match[p].wicketsTaken;
+            }
+        }
+    }
+    strikeRates.clear();
+    long long runs = 0;
+    for (const auto& player : season) {
+        strikeRates.push_back(player.ballsPlayed > 0 ? 100.0 * player.runsScored / player.ballsPlayed : 0.0);
+        runs += player.runsScored;
+    }
+    return runs;
+}
+
+// --- Columnar layout: per-match PlayerStatsStore folded into season totals ---
+long long aggregateWithMatchColumns(const std::vector<Player>& pool, const std::vector<Delivery>& deliveries,
+                                    long long totalDeliveries, std::vector<double>& strikeRates) {
+    PlayerStatsStore<int> match = PlayerStatsStore<int>::fromPool(pool);
+    PlayerStatsStore<long long> season = PlayerStatsStore<long long>::fromPool(pool);
+    long long done = 0;
+    while (done < totalDeliveries) {
+        for (size_t start = 0; start < deliveries.size() && done < totalDeliveries;
+             start += DELIVERIES_PER_MATCH, done += DELIVERIES_PER_MATCH) {
+            match.reset();
+            for (size_t i = start; i < start + DELIVERIES_PER_MATCH; ++i) {
+                const Delivery& d = deliveries[i];
+                match.recordDelivery(d.batsmanId, d.bowlerId, d.runs, d.runs == 0);
+            }
+            season.accumulate(match);
+        }
+    }
+    season.strikeRates(strikeRates);
+    return season.total(RUNS_SCORED);
+}
+
+// --- Columnar layout: deliveries recorded straight into the season store by player id ---
+long long aggregateWithSeasonColumns(const std::vector<Player>& pool, const std::vector<Delivery>& deliveries,
+                                     long long totalDeliveries, std::vector<double>& strikeRates) {
+    PlayerStatsStore<long long> season = PlayerStatsStore<long long>::fromPool(pool);
+    long long done = 0;
+    while (done < totalDeliveries) {
+        for (size_t i = 0; i < deliveries.size() && done < totalDeliveries; ++i, ++done) {
+            const Delivery& d = deliveries[i];
+            season.recordDelivery(d.batsmanId, d.bowlerId, d.runs, d.runs == 0);
+        }
+    }
+    season.strikeRates(strikeRates);
+    return season.total(RUNS_SCORED);
+}
+
+// --- Benchmark: player stats layouts ---
+int main(int argc, char* argv[]) {
+    long long totalDeliveries = (argc > 1) ? atoll(argv[1]) : 100000000;
+    totalDeliveries -= totalDeliveries % DELIVERIES_PER_MATCH; // Whole matches only
+
+    Game game;
+    Rng rng(42);
+    std::vector<Delivery> deliveries(DELIVERIES_PER_MATCH * 100000);
+    for (auto& d : deliveries) {
+        d.batsmanId = 1 + rng.below(11);
+        d.bowlerId = 1 + rng.below(11);
+        d.runs = rng.below(7);
+    }
+
+    std::vector<double> playerRates, matchRates, seasonRates;
+
+    auto t0 = std::chrono::steady_clock::now();
+    long long playerRuns = aggregateWithPlayers(game.allPlayers, deliveries, totalDeliveries, playerRates);
+    auto t1 = std::chrono::steady_clock::now();
+    long long matchRuns = aggregateWithMatchColumns(game.allPlayers, deliveries, totalDeliveries, matchRates);
+    auto t2 = std::chrono::steady_clock::now();
+    long long seasonRuns = aggregateWithSeasonColumns(game.allPlayers, deliveries, totalDeliveries, seasonRates);
+    auto t3 = std::chrono::steady_clock::now();
+
+    double playerSeconds = std::chrono::duration<double>(t1 - t0).count();
+    double matchSeconds = std::chrono::duration<double>(t2 - t1).count();
+    double seasonSeconds = std::chrono::duration<double>(t3 - t2).count();
+    std::cout << "Deliveries: " << totalDeliveries << "\n";
+    std::cout << "Layout\t\t\tSeconds\tDeliveries/s\tSpeedup\n";
+    std::cout << "Player records\t\t" << playerSeconds << "\t" << totalDeliveries / playerSeconds << "\t1\n";
+    std::cout << "Columns per match\t" << matchSeconds << "\t" << totalDeliveries / matchSeconds
+              << "\t" << playerSeconds / matchSeconds << "\n";
+    std::cout << "Columns by player id\t" << seasonSeconds << "\t" << totalDeliveries / seasonSeconds
+              << "\t" << playerSeconds / seasonSeconds << "\n";
+    std::cout << "Totals match: " << (playerRuns == matchRuns && playerRuns == seasonRuns ? "yes" : "NO") << "\n";
+    return 0;
+}
@@ -0,0 +1,149 @@
+#ifndef CRICKET_TEAM_H
+#define CRICKET_TEAM_H
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Outcomes of one delivery: 0-6 runs, where 0 is a wicket
+const int NUM_OUTCOMES = 7;
+
+// How a batsman was dismissed (the uniform model's only wicket, scoring 0, counts as BOWLED)
+enum DismissalKind {
+    NOT_OUT,
+    BOWLED,
+    CAUGHT,
+    LBW,
+    RUN_OUT,
+    STUMPED,
+    NUM_DISMISSAL_KINDS
+};
+
+// --- SkillProfile Definition ---
+// Relative weight of each outcome (0-6 runs) for one side of a delivery.
+// All weights equal (the default) means no preference either way.
+struct SkillProfile {
+    float weights[NUM_OUTCOMES];
+
+    // Constructor: neutral profile
+    SkillProfile() {
+        for (int runs = 0; runs < NUM_OUTCOMES; ++runs) {
+            weights[runs] = 1.0f;
+        }
+    }
+
+    SkillProfile(float w0, float w1, float w2, float w3, float w4, float w5, float w6) :
+        weights{w0, w1, w2, w3, w4, w5, w6} {}
+
+    // New stamp for a changed profile; 0 is never issued and marks the neutral default
+    static uint32_t nextStamp() {
+        static std::atomic<uint32_t> counter(0);
+        return ++counter;
+    }
+};
+
+// --- Player Class Definition ---
+class Player {
+public:
+    std::string name;
+    int id;
+    int runsScored;
+    int ballsPlayed;
+    int ballsBowled;
+    int runsGiven;
+    int wicketsTaken;
+    bool isOut;
+    DismissalKind dismissal;
+    SkillProfile batting;   // Weights of scoring 0-6 off a ball faced
+    SkillProfile bowling;   // Weights of conceding 0-6 off a ball bowled
+    uint32_t profileStamp;  // Changes with every setProfiles(), so cached matchups know when to rebuild
+
+    // Constructor
+    Player(std::string name, int id) :
+        name(name),
+        id(id),
+        runsScored(0),
+        ballsPlayed(0),
+        ballsBowled(0),
+        runsGiven(0),
+        wicketsTaken(0),
+        isOut(false),
+        dismissal(NOT_OUT),
+        profileStamp(0) {}
+
+    // Replaces both skill profiles
+    void setProfiles(const SkillProfile& battingProfile, const SkillProfile& bowlingProfile) {
+        batting = battingProfile;
+        bowling = bowlingProfile;
+        profileStamp = SkillProfile::nextStamp();
+    }
+
+    // Zeroes the match counters, keeping name and id
+    void resetStats() {
+        runsScored = 0;
+        ballsPlayed = 0;
+        ballsBowled = 0;
+        runsGiven = 0;
+        wicketsTaken = 0;
+        isOut = false;
+        dismissal = NOT_OUT;
+    }
+
+    // Displays player's current stats
+    void displayStats() const {
+        std::cout << "\t" << name
+                  << "\t\tRuns: " << runsScored
+                  << "\tBalls: " << ballsPlayed
+                  << "\tWickets: " << wicketsTaken
+                  << "\tRuns Given: " << runsGiven
+                  << "\n";
+    }
+};
+
+// --- Team Class Definition ---
+class Team {
+public:
+    std::string name;
+    std::vector<Player> players; // List of players in the team
+    int totalRuns;
+    int totalWicketsLost;
+    int totalBallsBowled;
+    int extras; // Wides and no-balls bowled to this team (included in totalRuns)
+
+    // Constructor
+    Team(std::string name) :
+        name(name),
+        totalRuns(0),
+        totalWicketsLost(0),
+        totalBallsBowled(0),
+        extras(0) {}
+
+    // Adds a player to the team
+    void addPlayer(const Player& player) {
+        players.push_back(player);
+    }
+
+    // Zeroes the team's and every player's counters, keeping the line-up
+    void resetStats() {
+        totalRuns = 0;
+        totalWicketsLost = 0;
+        totalBallsBowled = 0;
+        extras = 0;
+        for (auto& player : players) {
+            player.resetStats();
+        }
+    }
+
+    // Displays all players in the team
+    void displayTeamPlayers() const {
+        std::cout << "\t" << name << " Players:\n";
+        for (const auto& player : players) {
+            std::cout << "\t\t" << player.name << "\n";
+        }
+        std::cout << "\n";
+    }
+};
+
+#endif // CRICKET_TEAM_H
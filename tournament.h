@@ -0,0 +1,423 @@
+#ifndef CRICKET_TOURNAMENT_H
+#define CRICKET_TOURNAMENT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "aligned_allocator.h"
+#include "game.h"
+#include "game_pool.h"
+#include "rng.h"
+#include "work_stealing_pool.h"
+
+// --- TournamentTeam Definition ---
+// A named side of player ids from the Game's pool, in batting order
+struct TournamentTeam {
+    std::string name;
+    std::vector<int> playerIds;
+};
+
+// One scheduled match; rounds hold fixtures with no team in two of them
+struct Fixture {
+    int round;
+    int home; // Plays as the Game's TeamA
+    int away; // Plays as the Game's TeamB
+};
+
+// Outcome of a fixture, from the home side's point of view
+struct FixtureResult {
+    int homeRuns;
+    int homeWickets;
+    int homeBalls;
+    int awayRuns;
+    int awayWickets;
+    int awayBalls;
+    int winner; // Team index, or -1 for a tie
+};
+
+// --- Standings Class Definition ---
+// League table updated one result at a time. Rows only hold running totals,
+// so recording a result is O(1); sorting happens only when a ranking is asked for.
+class Standings {
+public:
+    static const int POINTS_FOR_WIN = 2;
+    static const int POINTS_FOR_TIE = 1;
+
+    struct Row {
+        int played;
+        int won;
+        int lost;
+        int tied;
+        int points;
+        long long runsFor;
+        long long ballsFaced;
+        long long runsAgainst;
+        long long ballsBowled;
+
+        // Runs per over scored minus runs per over conceded
+        double netRunRate() const {
+            double scored = ballsFaced > 0 ? 6.0 * runsFor / ballsFaced : 0.0;
+            double conceded = ballsBowled > 0 ? 6.0 * runsAgainst / ballsBowled : 0.0;
+            return scored - conceded;
+        }
+    };
+
+    std::vector<Row> rows; // One per team, in team order
+
+    // Constructor
+    explicit Standings(int numTeams) :
+        rows(numTeams) {
+        reset();
+    }
+
+    // Empties the table for a new season
+    void reset() {
+        for (auto& row : rows) {
+            row = Row();
+        }
+    }
+
+    // Adds one result to both teams' rows. A side bowled out is charged its full
+    // quota of 'maxDeliveries' balls, as net run rate rules require.
+    void record(const Fixture& fixture, const FixtureResult& result, int maxDeliveries, int playersPerTeam) {
+        int homeFaced = result.homeWickets >= playersPerTeam ? maxDeliveries : result.homeBalls;
+        int awayFaced = result.awayWickets >= playersPerTeam ? maxDeliveries : result.awayBalls;
+        addInnings(rows[fixture.home], result.homeRuns, homeFaced, result.awayRuns, awayFaced);
+        addInnings(rows[fixture.away], result.awayRuns, awayFaced, result.homeRuns, homeFaced);
+
+        if (result.winner < 0) {
+            rows[fixture.home].tied++;
+            rows[fixture.away].tied++;
+            rows[fixture.home].points += POINTS_FOR_TIE;
+            rows[fixture.away].points += POINTS_FOR_TIE;
+        } else {
+            int loser = result.winner == fixture.home ? fixture.away : fixture.home;
+            rows[result.winner].won++;
+            rows[result.winner].points += POINTS_FOR_WIN;
+            rows[loser].lost++;
+        }
+    }
+
+    // Fills 'order' with team indices from top to bottom: points, then net run rate, then team order
+    void rank(std::vector<int>& order) const {
+        order.resize(rows.size());
+        for (size_t i = 0; i < rows.size(); ++i) {
+            order[i] = static_cast<int>(i);
+        }
+        std::sort(order.begin(), order.end(), [this](int a, int b) {
+            if (rows[a].points != rows[b].points) {
+                return rows[a].points > rows[b].points;
+            }
+            double nrrA = rows[a].netRunRate();
+            double nrrB = rows[b].netRunRate();
+            if (nrrA != nrrB) {
+                return nrrA > nrrB;
+            }
+            return a < b;
+        });
+    }
+
+    // Index of the team on top of the table
+    int leader() const {
+        int best = 0;
+        for (int i = 1; i < static_cast<int>(rows.size()); ++i) {
+            const Row& row = rows[i];
+            const Row& top = rows[best];
+            if (row.points > top.points || (row.points == top.points && row.netRunRate() > top.netRunRate())) {
+                best = i;
+            }
+        }
+        return best;
+    }
+
+    void print(std::ostream& out, const std::vector<TournamentTeam>& teams) const {
+        std::vector<int> order;
+        rank(order);
+        out << "Pos\tTeam\t\tP\tW\tL\tT\tPts\tNRR\n";
+        for (size_t i = 0; i < order.size(); ++i) {
+            const Row& row = rows[order[i]];
+            out << (i + 1) << "\t" << teams[order[i]].name << "\t" << row.played << "\t" << row.won << "\t"
+                << row.lost << "\t" << row.tied << "\t" << row.points << "\t" << row.netRunRate() << "\n";
+        }
+    }
+
+private:
+    static void addInnings(Row& row, int runsFor, int ballsFaced, int runsAgainst, int ballsBowled) {
+        row.played++;
+        row.runsFor += runsFor;
+        row.ballsFaced += ballsFaced;
+        row.runsAgainst += runsAgainst;
+        row.ballsBowled += ballsBowled;
+    }
+};
+
+// --- TitleOdds Definition ---
+// How often each team won the title over many simulated seasons
+struct TitleOdds {
+    long long seasons;
+    long long matches;
+    std::vector<long long> titles;
+    std::vector<long long> points; // League points summed over all seasons
+
+    explicit TitleOdds(int numTeams = 0) :
+        seasons(0),
+        matches(0),
+        titles(numTeams, 0),
+        points(numTeams, 0) {}
+
+    void merge(const TitleOdds& other) {
+        seasons += other.seasons;
+        matches += other.matches;
+        for (size_t i = 0; i < titles.size(); ++i) {
+            titles[i] += other.titles[i];
+            points[i] += other.points[i];
+        }
+    }
+
+    void print(std::ostream& out, const std::vector<TournamentTeam>& teams, bool knockout) const {
+        double n = seasons > 0 ? static_cast<double>(seasons) : 1.0;
+        out << "Seasons: " << seasons << "\n";
+        out << "Matches: " << matches << "\n";
+        out << (knockout ? "Team\t\tTitle probability\n" : "Team\t\tTitle probability\tMean points\n");
+        for (size_t i = 0; i < teams.size(); ++i) {
+            out << teams[i].name << "\t" << titles[i] / n;
+            if (!knockout) {
+                out << "\t\t\t" << points[i] / n;
+            }
+            out << "\n";
+        }
+    }
+};
+
+// --- Tournament Class Definition ---
+// Round-robin leagues and knockout brackets between teams drawn from the
+// Game's player pool. Fixture f of season s always plays on RNG stream
+// s * streamsPerSeason() + f of the master seed, so every result (and every
+// title count) is the same whatever the number of threads or order of play.
+class Tournament {
+public:
+    std::vector<TournamentTeam> teams;
+    std::vector<Fixture> fixtures; // Round-robin schedule, round by round
+    int numRounds;
+    int maxDeliveries;
+    int playersPerTeam;
+    uint64_t masterSeed;
+
+    // Constructor: 'numTeams' sides of 'playersPerTeam' from 'pool', each playing
+    // every other side once per leg, in innings of 'maxDeliveries' balls
+    Tournament(int numTeams, int maxDeliveries, int playersPerTeam, const std::vector<Player>& pool,
+               uint64_t masterSeed, int legs = 1) :
+        teams(makeTeams(numTeams, playersPerTeam, pool)),
+        numRounds(0),
+        maxDeliveries(maxDeliveries),
+        playersPerTeam(playersPerTeam),
+        masterSeed(masterSeed)
+    {
+        scheduleRoundRobin(legs);
+    }
+
+    // Sides with consecutive runs of pool players (wrapping around), named after their captain
+    static std::vector<TournamentTeam> makeTeams(int numTeams, int playersPerTeam, const std::vector<Player>& pool) {
+        int poolSize = static_cast<int>(pool.size());
+        std::vector<TournamentTeam> teams(numTeams);
+        for (int t = 0; t < numTeams; ++t) {
+            int first = (playersPerTeam < poolSize) ? (t * playersPerTeam) % poolSize : t % poolSize;
+            for (int i = 0; i < playersPerTeam; ++i) {
+                teams[t].playerIds.push_back(pool[(first + i) % poolSize].id);
+            }
+            teams[t].name = pool[first].name + " XI";
+            if (t >= poolSize) {
+                teams[t].name += " " + std::to_string(t / poolSize + 1);
+            }
+        }
+        return teams;
+    }
+
+    // Builds the round-robin schedule with the circle method: one team stays put
+    // while the others rotate, giving n-1 rounds (n with a bye for odd n) per leg
+    void scheduleRoundRobin(int legs) {
+        fixtures.clear();
+        int n = static_cast<int>(teams.size());
+        int slots = n + (n % 2); // A bye slot (index n) for an odd number of teams
+        std::vector<int> circle(slots);
+        for (int i = 0; i < slots; ++i) {
+            circle[i] = i;
+        }
+        int roundsPerLeg = slots - 1;
+        numRounds = roundsPerLeg * legs;
+        for (int leg = 0; leg < legs; ++leg) {
+            for (int r = 0; r < roundsPerLeg; ++r) {
+                for (int i = 0; i < slots / 2; ++i) {
+                    int a = circle[i];
+                    int b = circle[slots - 1 - i];
+                    if (a >= n || b >= n) {
+                        continue; // Bye
+                    }
+                    bool swap = ((r + i) % 2 == 1) != (leg % 2 == 1); // Alternate home and away
+                    Fixture fixture = {leg * roundsPerLeg + r, swap ? b : a, swap ? a : b};
+                    fixtures.push_back(fixture);
+                }
+                std::rotate(circle.begin() + 1, circle.end() - 1, circle.end());
+            }
+        }
+    }
+
+    // RNG streams reserved for each season (enough for a league or a knockout)
+    long long streamsPerSeason() const {
+        return std::max<long long>(fixtures.size(), teams.size());
+    }
+
+    // Plays one match between two teams on 'game' (no I/O), on RNG stream 'stream'
+    FixtureResult playFixture(Game& game, int home, int away, long long stream) const {
+        game.maxDeliveries = maxDeliveries;
+        game.playersPerTeam = playersPerTeam;
+        game.fieldTeams(teams[home].playerIds, teams[away].playerIds);
+        game.rng = Rng::forStream(masterSeed, stream);
+        game.decideToss(1, 0);
+        game.simulateInnings(1);
+        game.simulateInnings(2);
+
+        const Team& a = game.teamA;
+        const Team& b = game.teamB;
+        FixtureResult result = {a.totalRuns, a.totalWicketsLost, a.totalBallsBowled,
+                                b.totalRuns, b.totalWicketsLost, b.totalBallsBowled,
+                                a.totalRuns > b.totalRuns ? home : b.totalRuns > a.totalRuns ? away : -1};
+        return result;
+    }
+
+    // Plays a whole league season on one Game, updating 'standings' after every fixture
+    void playLeagueSeason(Game& game, long long season, Standings& standings) const {
+        standings.reset();
+        long long firstStream = season * streamsPerSeason();
+        for (size_t f = 0; f < fixtures.size(); ++f) {
+            FixtureResult result = playFixture(game, fixtures[f].home, fixtures[f].away, firstStream + f);
+            standings.record(fixtures[f], result, maxDeliveries, playersPerTeam);
+        }
+    }
+
+    // Plays a league season round by round, with the fixtures of each round running
+    // concurrently on 'workers' (worker w plays on games[w]); standings are updated
+    // as each round completes. Returns every fixture's result, in schedule order.
+    std::vector<FixtureResult> playLeagueSeason(WorkStealingPool& workers, const std::vector<Game*>& games,
+                                                long long season, Standings& standings) const {
+        standings.reset();
+        std::vector<FixtureResult> results(fixtures.size());
+        long long firstStream = season * streamsPerSeason();
+        size_t f = 0;
+        while (f < fixtures.size()) {
+            size_t roundEnd = f;
+            while (roundEnd < fixtures.size() && fixtures[roundEnd].round == fixtures[f].round) {
+                roundEnd++;
+            }
+            for (size_t i = f; i < roundEnd; ++i) {
+                workers.submit([this, &games, &results, i, firstStream](int w) {
+                    results[i] = playFixture(*games[w], fixtures[i].home, fixtures[i].away, firstStream + i);
+                });
+            }
+            workers.wait();
+            for (size_t i = f; i < roundEnd; ++i) {
+                standings.record(fixtures[i], results[i], maxDeliveries, playersPerTeam);
+            }
+            f = roundEnd;
+        }
+        return results;
+    }
+
+    // Plays a knockout bracket on one Game and returns the champion. Teams are
+    // seeded in order (first plays last); byes fill the bracket to a power of two.
+    // A tied match goes to the side that lost fewer wickets, then to a coin toss.
+    int playKnockout(Game& game, long long season, int* matchesPlayed = nullptr) const {
+        int n = static_cast<int>(teams.size());
+        int size = 1;
+        while (size < n) {
+            size *= 2;
+        }
+        std::vector<int> current(size);
+        std::vector<int> next(size / 2);
+        for (int i = 0; i < size / 2; ++i) {
+            current[2 * i] = i;
+            current[2 * i + 1] = (size - 1 - i < n) ? size - 1 - i : -1; // -1 = bye
+        }
+
+        long long stream = season * streamsPerSeason();
+        int played = 0;
+        for (int remaining = size; remaining > 1; remaining /= 2) {
+            for (int i = 0; i < remaining / 2; ++i) {
+                int home = current[2 * i];
+                int away = current[2 * i + 1];
+                if (home < 0 || away < 0) {
+                    next[i] = home < 0 ? away : home;
+                    continue;
+                }
+                FixtureResult result = playFixture(game, home, away, stream++);
+                played++;
+                if (result.winner < 0) {
+                    result.winner = result.homeWickets < result.awayWickets   ? home
+                                    : result.awayWickets < result.homeWickets ? away
+                                    : (game.rng.below(2) == 0 ? home : away);
+                }
+                next[i] = result.winner;
+            }
+            std::swap(current, next);
+        }
+        if (matchesPlayed != nullptr) {
+            *matchesPlayed = played;
+        }
+        return current[0];
+    }
+
+    // Simulates seasons [0, numSeasons) across 'workers' and counts each team's
+    // titles (league winner, or knockout champion if 'knockout')
+    TitleOdds simulateSeasons(WorkStealingPool& workers, long long numSeasons, bool knockout) const {
+        // Per-worker Games from one arena, and per-worker tallies merged at the end
+        GamePool games(workers.size());
+        struct alignas(64) Tally {
+            Game* game;
+            TitleOdds odds;
+            Standings standings;
+            Tally(Game* game, int numTeams) : game(game), odds(numTeams), standings(numTeams) {}
+        };
+        std::vector<Tally, AlignedAllocator<Tally>> tallies; // One cache line or more each
+        tallies.reserve(workers.size());
+        for (int w = 0; w < workers.size(); ++w) {
+            tallies.emplace_back(games.acquire(), static_cast<int>(teams.size()));
+        }
+
+        const long long blockSeasons = 16;
+        for (long long first = 0; first < numSeasons; first += blockSeasons) {
+            long long last = std::min(first + blockSeasons, numSeasons);
+            workers.submit([this, &tallies, first, last, knockout](int w) {
+                Tally& tally = tallies[w];
+                for (long long season = first; season < last; ++season) {
+                    int champion;
+                    if (knockout) {
+                        int played = 0;
+                        champion = playKnockout(*tally.game, season, &played);
+                        tally.odds.matches += played;
+                    } else {
+                        playLeagueSeason(*tally.game, season, tally.standings);
+                        champion = tally.standings.leader();
+                        tally.odds.matches += fixtures.size();
+                        for (size_t t = 0; t < teams.size(); ++t) {
+                            tally.odds.points[t] += tally.standings.rows[t].points;
+                        }
+                    }
+                    tally.odds.titles[champion]++;
+                    tally.odds.seasons++;
+                }
+            });
+        }
+        workers.wait();
+
+        TitleOdds odds(static_cast<int>(teams.size()));
+        for (auto& tally : tallies) {
+            odds.merge(tally.odds);
+            games.release(tally.game);
+        }
+        return odds;
+    }
+};
+
+#endif // CRICKET_TOURNAMENT_H
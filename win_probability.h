@@ -0,0 +1,142 @@
+#ifndef CRICKET_WIN_PROBABILITY_H
+#define CRICKET_WIN_PROBABILITY_H
+
+#include <cstddef>
+#include <vector>
+#include "game.h"
+#include "match_format.h"
+#include "probability.h"
+
+// --- WinPredictor Class Definition ---
+// Live win probability for one MatchFormat from any moment of a match, as
+// table lookups over the exact innings engine. In innings 2 the chance is
+// read straight off ExactInnings (runs needed from balls and wickets left).
+// In innings 1 it also depends on the runs already scored, so a second table
+// is built backwards from the end of the innings: the value of a finished
+// first innings of r runs is P(the chase falls short of r), and every earlier
+// state averages the states one ball later. Runs so far in a state with b
+// balls left are at most (balls - b) * maxRuns, so each row is only that long.
+template <typename Format>
+class WinPredictor {
+public:
+    static const int balls = Format::balls;
+    static const int players = Format::players;
+    static const int maxRuns = Format::Runs::maxRuns;
+
+    // Builds the first-innings tables (one pass, fewest balls left first)
+    WinPredictor() :
+        exact(exactInnings<Format>())
+    {
+        offsets.resize((balls + 1) * (players + 1) + 1);
+        size_t offset = 0;
+        for (int b = 0; b <= balls; ++b) {
+            for (int w = 0; w <= players; ++w) {
+                offsets[index(b, w)] = offset;
+                offset += rowLength(b);
+            }
+        }
+        offsets.back() = offset;
+        firstWins.assign(offset, 0.0f);
+        firstDraws.assign(offset, 0.0f);
+
+        for (int b = 0; b <= balls; ++b) {
+            for (int w = 0; w <= players; ++w) {
+                float* wins = &firstWins[offsets[index(b, w)]];
+                float* draws = &firstDraws[offsets[index(b, w)]];
+                int length = rowLength(b);
+                if (b == 0 || w == 0) {
+                    // Innings over on 'runs': the chase starts from the top
+                    for (int runs = 0; runs < length; ++runs) {
+                        double chaseWins = exact.chaseWinProbability(runs + 1);
+                        double tie = exact.probabilityOfRuns(balls, players, runs);
+                        wins[runs] = static_cast<float>(1.0 - chaseWins - tie);
+                        draws[runs] = static_cast<float>(tie);
+                    }
+                    continue;
+                }
+                for (int k = 0; k <= maxRuns; ++k) {
+                    float p = static_cast<float>(Format::Runs::probability(k));
+                    int nextWickets = Format::Out::isOut(k) ? w - 1 : w;
+                    const float* nextWins = &firstWins[offsets[index(b - 1, nextWickets)] + k];
+                    const float* nextDraws = &firstDraws[offsets[index(b - 1, nextWickets)] + k];
+                    for (int runs = 0; runs < length; ++runs) {
+                        wins[runs] += p * nextWins[runs];
+                        draws[runs] += p * nextDraws[runs];
+                    }
+                }
+            }
+        }
+    }
+
+    // Chance that the batting side wins, and of a tie, with 'ballsBowled' balls gone in
+    // innings 'inningsNum', 'wicketsLost' down and 'runs' scored; 'firstInningsRuns' is
+    // the total to beat in innings 2
+    WinChance predict(int inningsNum, int ballsBowled, int wicketsLost, int runs, int firstInningsRuns) const {
+        int ballsLeft = clamp(balls - ballsBowled, balls);
+        int wicketsLeft = clamp(players - wicketsLost, players);
+        if (inningsNum == 2) {
+            int runsNeeded = firstInningsRuns + 1 - runs;
+            WinChance chance = {static_cast<float>(exact.chaseWinProbability(ballsLeft, wicketsLeft, runsNeeded)),
+                                static_cast<float>(exact.probabilityOfRuns(ballsLeft, wicketsLeft, runsNeeded - 1))};
+            return chance;
+        }
+        size_t at = offsets[index(ballsLeft, wicketsLeft)] + clamp(runs, rowLength(ballsLeft) - 1);
+        WinChance chance = {firstWins[at], firstDraws[at]};
+        return chance;
+    }
+
+private:
+    const ExactInnings<Format>& exact;
+    std::vector<size_t> offsets;   // Start of each (balls left, wickets left) row
+    std::vector<float> firstWins;  // P(batting first wins) by runs so far
+    std::vector<float> firstDraws; // P(tie) by runs so far
+
+    static int index(int ballsLeft, int wicketsLeft) {
+        return ballsLeft * (players + 1) + wicketsLeft;
+    }
+
+    static int rowLength(int ballsLeft) {
+        return (balls - ballsLeft) * maxRuns + 1;
+    }
+
+    static int clamp(int value, int high) {
+        return value < 0 ? 0 : value > high ? high : value;
+    }
+};
+
+// Shared, lazily built predictor for one format (built once on first use)
+template <typename Format>
+const WinPredictor<Format>& winPredictor() {
+    static const WinPredictor<Format> predictor;
+    return predictor;
+}
+
+// WinPredictorFunction for one format
+template <typename Format>
+WinChance predictWin(int inningsNum, int ballsBowled, int wicketsLost, int runs, int firstInningsRuns) {
+    return winPredictor<Format>().predict(inningsNum, ballsBowled, wicketsLost, runs, firstInningsRuns);
+}
+
+// Runtime lookup of the predictor for innings of 'balls' deliveries and teams of
+// 'players' (the formats of formatTable()); nullptr if there is none. The tables
+// are built here, so the first ball does not pay for them.
+inline WinPredictorFunction findWinPredictor(int balls, int players) {
+    static const struct {
+        int balls;
+        int players;
+        WinPredictorFunction predict;
+    } table[] = {
+        {OneOverFormat::balls, OneOverFormat::players, &predictWin<OneOverFormat>},
+        {T20Format::balls, T20Format::players, &predictWin<T20Format>},
+        {OdiFormat::balls, OdiFormat::players, &predictWin<OdiFormat>},
+    };
+    for (const auto& entry : table) {
+        if (entry.balls == balls && entry.players == players) {
+            entry.predict(1, 0, 0, 0, 0);
+            return entry.predict;
+        }
+    }
+    return nullptr;
+}
+
+#endif // CRICKET_WIN_PROBABILITY_H
@@ -0,0 +1,189 @@
+#ifndef CRICKET_WORK_STEALING_POOL_H
+#define CRICKET_WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib> // For posix_memalign() and free()
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+// --- WorkStealingPool Class Definition ---
+// Fixed set of worker threads, each with its own task deque. A worker runs
+// its newest task first and, when its deque is empty, steals the oldest task
+// from another worker, so uneven tasks (a long chase, a short innings) keep
+// every core busy without one shared queue everybody contends on.
+// Tasks receive the index of the worker running them, for per-worker state.
+class WorkStealingPool {
+public:
+    typedef std::function<void(int)> Task;
+
+    // Constructor: 0 threads means one per hardware core
+    explicit WorkStealingPool(int numThreads = 0) :
+        queued(0),
+        pending(0),
+        stealCount(0),
+        nextQueue(0),
+        stopping(false)
+    {
+        int n = numThreads > 0 ? numThreads : static_cast<int>(std::thread::hardware_concurrency());
+        n = n > 0 ? n : 1;
+        for (int i = 0; i < n; ++i) {
+            queues.emplace_back(newQueue());
+        }
+        for (int i = 0; i < n; ++i) {
+            threads.emplace_back(&WorkStealingPool::workerLoop, this, i);
+        }
+    }
+
+    // Stops the workers; call wait() first so no queued task is dropped
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(idleMutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    int size() const {
+        return static_cast<int>(queues.size());
+    }
+
+    // Queues a task: on the calling worker's own deque when called from a task,
+    // otherwise on the workers' deques in turn
+    void submit(Task task) {
+        int target = (currentPool() == this) ? currentWorker() : static_cast<int>(nextQueue++ % queues.size());
+        pending.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(queues[target]->mutex);
+            queues[target]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(idleMutex);
+            queued++;
+        }
+        wake.notify_one();
+    }
+
+    // Blocks until every submitted task, including tasks submitted by tasks, has finished
+    void wait() {
+        std::unique_lock<std::mutex> lock(idleMutex);
+        done.wait(lock, [this]() { return pending.load() == 0; });
+    }
+
+    // Number of tasks run by a worker other than the one they were queued on
+    long long steals() const {
+        return stealCount.load();
+    }
+
+private:
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    // Destroys a Queue made by newQueue()
+    struct QueueDeleter {
+        void operator()(Queue* queue) const {
+            queue->~Queue();
+            std::free(queue);
+        }
+    };
+
+    std::vector<std::unique_ptr<Queue, QueueDeleter>> queues;
+    std::vector<std::thread> threads;
+    std::mutex idleMutex;               // Guards sleeping, waking and finishing
+    std::condition_variable wake;       // Signalled when a task is queued or the pool stops
+    std::condition_variable done;       // Signalled when the last pending task finishes
+    std::atomic<long long> queued;      // Tasks sitting in deques
+    std::atomic<long long> pending;     // Tasks submitted and not yet finished
+    std::atomic<long long> stealCount;
+    std::atomic<unsigned> nextQueue;    // Round-robin target for submissions from outside the pool
+    bool stopping;
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    static const WorkStealingPool*& currentPool() {
+        static thread_local const WorkStealingPool* pool = nullptr;
+        return pool;
+    }
+
+    static int& currentWorker() {
+        static thread_local int worker = -1;
+        return worker;
+    }
+
+    // A Queue on cache lines of its own (before C++17, plain new only aligns to 16 bytes)
+    static Queue* newQueue() {
+        void* memory = nullptr;
+        if (posix_memalign(&memory, alignof(Queue), sizeof(Queue)) != 0) {
+            throw std::bad_alloc();
+        }
+        try {
+            return new (memory) Queue();
+        } catch (...) {
+            std::free(memory);
+            throw;
+        }
+    }
+
+    // Newest task of worker 'w'
+    bool popLocal(int w, Task& task) {
+        std::lock_guard<std::mutex> lock(queues[w]->mutex);
+        if (queues[w]->tasks.empty()) {
+            return false;
+        }
+        task = std::move(queues[w]->tasks.back());
+        queues[w]->tasks.pop_back();
+        return true;
+    }
+
+    // Oldest task of the first other worker that has one
+    bool steal(int w, Task& task) {
+        int n = static_cast<int>(queues.size());
+        for (int k = 1; k < n; ++k) {
+            Queue& victim = *queues[(w + k) % n];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                stealCount.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop(int w) {
+        currentPool() = this;
+        currentWorker() = w;
+        Task task;
+        while (true) {
+            if (popLocal(w, task) || steal(w, task)) {
+                queued--;
+                task(w);
+                task = nullptr;
+                if (pending.fetch_sub(1) == 1) {
+                    std::lock_guard<std::mutex> lock(idleMutex);
+                    done.notify_all();
+                }
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(idleMutex);
+            wake.wait(lock, [this]() { return stopping || queued.load() > 0; });
+            if (stopping) {
+                return;
+            }
+        }
+    }
+};
+
+#endif // CRICKET_WORK_STEALING_POOL_H